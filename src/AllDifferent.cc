@@ -0,0 +1,315 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : AllDifferent.cc
+//**************************************************************
+
+//Including Libraries and Header Files
+#include "AllDifferent.h"
+#include <climits>
+#include <algorithm>
+using namespace std;
+//**************************************************************
+//Start of Code
+
+//Two argument constructor
+AllDifferent::AllDifferent(const vector <int> & vars, const vector <Variable *> & varlist)
+{
+  VARS = vars;
+  VALUES = 0;
+  for(unsigned int i = 0; i < VARS.size(); i++)
+    if(VALUES < varlist[VARS[i]]->DOMAINSIZE)
+      VALUES = varlist[VARS[i]]->DOMAINSIZE;
+  MATCH.assign(VARS.size(), -1);
+  MATE.assign(VALUES, -1);
+  VISITED.assign(VALUES, 0);
+  STAMP = 0;
+  COUNTER = 0;
+  COMPONENTS = 0;
+}
+
+//inDomain
+bool AllDifferent::inDomain(const vector <Variable *> & varlist, int i, int value) const
+{
+  Variable * variable = varlist[VARS[i]];
+  return value < variable->DOMAINSIZE && variable->ATOMASSIGN[value] != -1;
+}
+
+//augment
+bool AllDifferent::augment(const vector <Variable *> & varlist, int i)
+{
+  int size = varlist[VARS[i]]->DOMAINSIZE;
+  //a free value ends the path at once
+  for(int value = 0; value < size; value++)
+    if(MATE[value] < 0 && VISITED[value] != STAMP && inDomain(varlist, i, value))
+      {
+	MATCH[i] = value;
+	MATE[value] = i;
+	return true;
+      }
+  for(int value = 0; value < size; value++)
+    if(VISITED[value] != STAMP && inDomain(varlist, i, value))
+      {
+	VISITED[value] = STAMP;
+	if(augment(varlist, MATE[value]))
+	  {
+	    MATCH[i] = value;
+	    MATE[value] = i;
+	    return true;
+	  }
+      }
+  return false;
+}
+
+//strongConnect
+void AllDifferent::strongConnect(const vector <Variable *> & varlist, int root)
+{
+  int vars = VARS.size();
+  INDEX[root] = LOW[root] = COUNTER++;
+  PATH.push_back(root);
+  FRAMES.push_back(make_pair(root, root < vars ? 0 : root - vars));
+
+  while(!FRAMES.empty())
+    {
+      int node = FRAMES.back().first;
+      int value = FRAMES.back().second;
+
+      //the successors of the node, a variable has those of its domain but its
+      //own value, a matched value has its variable
+      int last = node < vars ? varlist[VARS[node]]->DOMAINSIZE : node - vars + 1;
+      int next = -1;
+      for(; value < last; value++)
+	{
+	  int succ;
+	  if(node < vars)
+	    {
+	      if(value == MATCH[node] || !inDomain(varlist, node, value))
+		continue;
+	      succ = vars + value;
+	    }
+	  else if(MATE[value] >= 0)
+	    succ = MATE[value];
+	  else
+	    continue;
+
+	  if(INDEX[succ] < 0)
+	    {
+	      next = succ;
+	      break;
+	    }
+	  if(COMPONENT[succ] < 0)
+	    LOW[node] = min(LOW[node], INDEX[succ]);
+	}
+
+      //numbers the successor first, the node goes on after it
+      if(next >= 0)
+	{
+	  FRAMES.back().second = value + 1;
+	  INDEX[next] = LOW[next] = COUNTER++;
+	  PATH.push_back(next);
+	  FRAMES.push_back(make_pair(next, next < vars ? 0 : next - vars));
+	  continue;
+	}
+
+      if(LOW[node] == INDEX[node])
+	{
+	  int member;
+	  do
+	    {
+	      member = PATH.back();
+	      PATH.pop_back();
+	      COMPONENT[member] = COMPONENTS;
+	    }
+	  while(member != node);
+	  COMPONENTS++;
+	}
+      FRAMES.pop_back();
+      if(!FRAMES.empty())
+	LOW[FRAMES.back().first] = min(LOW[FRAMES.back().first], LOW[node]);
+    }
+}
+
+//hallSet
+void AllDifferent::hallSet(const vector <Variable *> & varlist, int node)
+{
+  int vars = VARS.size();
+  if(++STAMP == INT_MAX)
+    {
+      VISITED.assign(VALUES, 0);
+      STAMP = 1;
+    }
+
+  //the variables reached, marking the values of their domains
+  NODES.clear();
+  NODES.push_back(node);
+  if(node >= vars)
+    VISITED[node - vars] = STAMP;
+  for(unsigned int k = 0; k < NODES.size(); k++)
+    {
+      int i = NODES[k];
+      if(i >= vars)
+	{
+	  if(MATE[i - vars] >= 0)
+	    NODES.push_back(MATE[i - vars]);
+	  continue;
+	}
+      for(int value = 0; value < varlist[VARS[i]]->DOMAINSIZE; value++)
+	if(VISITED[value] != STAMP && inDomain(varlist, i, value))
+	  {
+	    VISITED[value] = STAMP;
+	    NODES.push_back(vars + value);
+	  }
+    }
+
+  //a variable that holds a value of the set is kept in it by its
+  //value, any other one by the atoms of the values outside of it
+  for(unsigned int k = 0; k < NODES.size(); k++)
+    {
+      int i = NODES[k];
+      if(i >= vars)
+	continue;
+      Variable * variable = varlist[VARS[i]];
+      if(variable->SAT)
+	BODY.push_back(makeLit(VARS[i], false, variable->VAL));
+      else
+	for(int value = 0; value < variable->DOMAINSIZE; value++)
+	  if(VISITED[value] != STAMP)
+	    BODY.push_back(makeLit(VARS[i], true, value));
+    }
+}
+
+//propagate
+bool AllDifferent::propagate(const vector <Variable *> & varlist, int, vector <LIT> & atoms, vector <int> & sizes)
+{
+  int vars = VARS.size();
+
+  //the matching of the last call loses the values taken away since
+  for(int i = 0; i < vars; i++)
+    if(MATCH[i] >= 0 && !inDomain(varlist, i, MATCH[i]))
+      {
+	MATE[MATCH[i]] = -1;
+	MATCH[i] = -1;
+      }
+
+  //a variable left unmatched heads a set of variables with too few values
+  for(int i = 0; i < vars; i++)
+    {
+      if(MATCH[i] >= 0)
+	continue;
+      if(++STAMP == INT_MAX)
+	{
+	  VISITED.assign(VALUES, 0);
+	  STAMP = 1;
+	}
+      if(!augment(varlist, i))
+	{
+	  BODY.clear();
+	  hallSet(varlist, i);
+	  atoms.insert(atoms.end(), BODY.begin(), BODY.end());
+	  sizes.push_back(BODY.size());
+	  return false;
+	}
+    }
+
+  //the nodes that reach a free value, following the edges backwards: a value
+  //reached gives the variables having it but not matched to it, a variable
+  //gives its matched value
+  FREE.assign(vars + VALUES, false);
+  NODES.clear();
+  for(int value = 0; value < VALUES; value++)
+    if(MATE[value] < 0)
+      {
+	FREE[vars + value] = true;
+	NODES.push_back(value);
+      }
+  for(unsigned int k = 0; k < NODES.size(); k++)
+    for(int i = 0; i < vars; i++)
+      if(!FREE[i] && MATCH[i] != NODES[k] && inDomain(varlist, i, NODES[k]))
+	{
+	  FREE[i] = true;
+	  if(!FREE[vars + MATCH[i]])
+	    {
+	      FREE[vars + MATCH[i]] = true;
+	      NODES.push_back(MATCH[i]);
+	    }
+	}
+
+  //the other values of a variable are kept on an even alternating cycle,
+  //found within a component
+  INDEX.assign(vars + VALUES, -1);
+  LOW.assign(vars + VALUES, 0);
+  COMPONENT.assign(vars + VALUES, -1);
+  PATH.clear();
+  COUNTER = 0;
+  COMPONENTS = 0;
+  for(int node = 0; node < vars + VALUES; node++)
+    if(INDEX[node] < 0)
+      strongConnect(varlist, node);
+
+  //the values reached from a value taken away are those of a Hall set, shared
+  //by the values of its component
+  HALL.assign(COMPONENTS, -1);
+  HALLSIZE.assign(COMPONENTS, 0);
+  BODY.clear();
+  for(int i = 0; i < vars; i++)
+    {
+      if(varlist[VARS[i]]->SAT)
+	continue;
+      for(int value = 0; value < varlist[VARS[i]]->DOMAINSIZE; value++)
+	{
+	  int node = vars + value;
+	  if(value == MATCH[i] || FREE[node] || COMPONENT[node] == COMPONENT[i]
+	     || !inDomain(varlist, i, value))
+	    continue;
+	  int component = COMPONENT[node];
+	  if(HALL[component] < 0)
+	    {
+	      HALL[component] = BODY.size();
+	      hallSet(varlist, node);
+	      HALLSIZE[component] = BODY.size() - HALL[component];
+	    }
+	  atoms.push_back(makeLit(VARS[i], false, value));
+	  atoms.insert(atoms.end(), BODY.begin() + HALL[component],
+		       BODY.begin() + HALL[component] + HALLSIZE[component]);
+	  sizes.push_back(1 + HALLSIZE[component]);
+	}
+    }
+  return true;
+}
+
+//holds
+bool AllDifferent::holds(const vector <Variable *> & varlist) const
+{
+  vector <bool> taken(VALUES, false);
+  for(unsigned int i = 0; i < VARS.size(); i++)
+    {
+      int value = varlist[VARS[i]]->VAL;
+      if(value < 0 || taken[value])
+	return false;
+      taken[value] = true;
+    }
+  return true;
+}
+
+//decompose
+void AllDifferent::decompose(const vector <Variable *> & varlist, vector <LIT> & atoms, vector <int> & sizes) const
+{
+  for(unsigned int i = 0; i < VARS.size(); i++)
+    for(unsigned int j = i + 1; j < VARS.size(); j++)
+      for(int value = 0; value < min(varlist[VARS[i]]->DOMAINSIZE, varlist[VARS[j]]->DOMAINSIZE); value++)
+	{
+	  atoms.push_back(makeLit(VARS[i], false, value));
+	  atoms.push_back(makeLit(VARS[j], false, value));
+	  sizes.push_back(2);
+	}
+}
+
+//clone
+Constraint * AllDifferent::clone(const vector <Variable *> & varlist) const
+{
+  return new AllDifferent(VARS, varlist);
+}
+
+// End of Code
+//**************************************************************
@@ -0,0 +1,104 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : AllDifferent.h
+// Description : Contains code for the alldifferent constraint,
+// which asks its variables to take pairwise different values. A
+// maximum matching of the variables to their values finds the
+// values no solution can give a variable, and each value taken
+// away is explained by a clause over the atoms that forced it, so
+// the search propagates and learns from it like from any clause.
+//**************************************************************
+#ifndef ALLDIFFERENT_H
+#define ALLDIFFERENT_H
+
+//Including Libraries and Header files
+#include <vector>
+#include <utility>
+
+#include "Constraint.h"
+
+using namespace std;
+
+//**************************************************************
+// AllDifferent
+// This class holds the variables of one alldifferent constraint and
+// the matching of its last propagation, which the next one starts
+// from. Propagation follows Regin: a value is taken from a variable
+// if no maximum matching gives it to the variable. Such a value
+// belongs to a Hall set, variables whose domains together hold as
+// many values as there are variables, and the atoms that keep the
+// other values out of these domains make up the explanation.
+//
+// Start of Code
+class AllDifferent : public Constraint
+{
+  //public variables and functions
+public:
+  //Two argument constructor : the constraint over the variables of vars,
+  //                           indices into varlist, which gives their domains
+  AllDifferent(const vector <int> & vars, const vector <Variable *> & varlist);
+  //VALUES = number of values, the size of the largest domain
+  int VALUES;
+  //propagate : fails if no matching covers the variables
+  bool propagate(const vector <Variable *> & varlist, int time, vector <LIT> & atoms, vector <int> & sizes);
+  //holds : returns true if the variables have pairwise different values
+  bool holds(const vector <Variable *> & varlist) const;
+  //decompose : a clause for each pair of variables and each value they share
+  void decompose(const vector <Variable *> & varlist, vector <LIT> & atoms, vector <int> & sizes) const;
+  //clone : returns the constraint over the same variables
+  Constraint * clone(const vector <Variable *> & varlist) const;
+  //private variables and functions
+private:
+  //MATCH = the value matched to each variable, -1 if none
+  //MATE = the variable matched to each value, -1 if none
+  //VISITED = stamp of the last search that visited each value
+  //STAMP = the current stamp
+  vector <int> MATCH;
+  vector <int> MATE;
+  vector <int> VISITED;
+  int STAMP;
+  //The graph of the matching has a node for each variable, then one for
+  //each value; a variable points to the values of its domain but its
+  //own, a matched value to its variable
+  //FREE = true for the nodes from which a value left unmatched is reached
+  //INDEX, LOW, COMPONENT = numbering of the strongly connected components
+  //PATH = nodes of the components being numbered
+  //FRAMES = the nodes being numbered, each with the next value whose
+  //         successor it looks at, in place of a recursion as deep as the graph
+  //COUNTER = number of nodes numbered so far
+  //COMPONENTS = number of components found so far
+  //HALL = where the atoms of the Hall set of each component start in BODY,
+  //       -1 if not built
+  //HALLSIZE = number of atoms of the Hall set of each component
+  //BODY = the atoms of the Hall sets built, one set after the other
+  vector <bool> FREE;
+  vector <int> INDEX;
+  vector <int> LOW;
+  vector <int> COMPONENT;
+  vector <int> PATH;
+  vector <pair <int, int> > FRAMES;
+  int COUNTER;
+  int COMPONENTS;
+  vector <int> HALL;
+  vector <int> HALLSIZE;
+  vector <LIT> BODY;
+  //NODES = nodes reached while building a Hall set
+  vector <int> NODES;
+  //inDomain : returns true if the value is still possible for the i-th variable
+  bool inDomain(const vector <Variable *> & varlist, int i, int value) const;
+  //augment : looks for an alternating path from the i-th variable to a free
+  //          value and flips the matching along it
+  bool augment(const vector <Variable *> & varlist, int i);
+  //strongConnect : numbers the components of the nodes reached from root,
+  //                Tarjan's way
+  void strongConnect(const vector <Variable *> & varlist, int root);
+  //hallSet : adds to BODY the atoms that keep the values reached from the node
+  //          out of the domains of the variables reached from it
+  void hallSet(const vector <Variable *> & varlist, int node);
+};
+// End of Code
+//
+#endif
+//**************************************************************
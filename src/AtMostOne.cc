@@ -0,0 +1,48 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : AtMostOne.cc
+//**************************************************************
+
+//Including Libraries and Header Files
+#include "AtMostOne.h"
+using namespace std;
+//**************************************************************
+//Start of Code
+
+//One argument constructor
+AtMostOne::AtMostOne(const vector <LIT> & atoms)
+  : ATOMS(atoms)
+{
+  COUNT = 0;
+  TRUEATOM = NOLIT;
+}
+
+//assign
+bool AtMostOne::assign(const vector <Variable *> & varlist, LIT atom, vector <LIT> & falsified)
+{
+  if(COUNT++ > 0)
+    return false;
+  TRUEATOM = atom;
+
+  //an atom that holds too is counted when its turn comes
+  for(unsigned int i = 0; i < ATOMS.size(); i++)
+    {
+      if(ATOMS[i] == atom
+	 || varlist[litVar(ATOMS[i])]->ATOMASSIGN[litVal(ATOMS[i])] != 0)
+	continue;
+      falsified.push_back(ATOMS[i]);
+    }
+  return true;
+}
+
+//unassign
+void AtMostOne::unassign()
+{
+  if(--COUNT == 0)
+    TRUEATOM = NOLIT;
+}
+
+// End of Code
+//**************************************************************
@@ -0,0 +1,52 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : AtMostOne.h
+// Description : Contains code for the at most one constraint, which
+// lets at most one of its atoms hold. It counts the atoms that hold
+// instead of pairing them in clauses. The atoms it falsifies have the
+// constraint as their reason, the clause of the atom and the one that
+// holds is only built when a conflict analysis resolves on them.
+//**************************************************************
+#ifndef ATMOSTONE_H
+#define ATMOSTONE_H
+
+//Including Libraries and Header files
+#include <vector>
+
+#include "Literal.h"
+#include "Variable.h"
+
+using namespace std;
+
+//**************************************************************
+// AtMostOne
+// This class holds the atoms of one at most one constraint and the
+// number of them that hold. The atoms are counted in the order they
+// are assigned and uncounted the other way round, so the first atom
+// counted is the one that holds while the count is one.
+//
+// Start of Code
+class AtMostOne
+{
+  //public variables and functions
+public:
+  //One argument constructor : the constraint over the atoms
+  AtMostOne(const vector <LIT> & atoms);
+  //ATOMS = the atoms of which at most one holds
+  //COUNT = number of atoms counted by assign that hold
+  //TRUEATOM = the first atom counted, NOLIT if none
+  vector <LIT> ATOMS;
+  int COUNT;
+  LIT TRUEATOM;
+  //assign : counts the atom, which holds now, and adds to falsified each
+  //         other atom still unassigned; returns false if another atom holds
+  bool assign(const vector <Variable *> & varlist, LIT atom, vector <LIT> & falsified);
+  //unassign : uncounts the last atom counted
+  void unassign();
+};
+// End of Code
+//
+#endif
+//**************************************************************
@@ -0,0 +1,228 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Batch.cc
+//**************************************************************
+
+//Including Libraries and Header Files
+#include "Batch.h"
+#include "Global.h"
+#include <cstring>
+#include <chrono>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+using namespace std;
+//**************************************************************
+//Start of Code
+
+//Two argument constructor
+RequestStream::RequestStream(const char * list, const char * socketpath)
+{
+  IN = NULL;
+  OUT = stdout;
+  LISTENER = -1;
+  PATH = NULL;
+  COUNT = 0;
+  QUIT = false;
+
+  if(list)
+    {
+      IN = strcmp(list, "-") ? fopen(list, "r") : stdin;
+      if(!IN)
+	{
+	  cout<<endl;
+	  cout<<"**** ERROR ****"<<endl;
+	  cout<<"Could not open batch list : "<<list<<endl;
+	  cout<<endl;
+	  exit(1);
+	}
+      return;
+    }
+
+  //a client that hangs up early must not kill the daemon
+  signal(SIGPIPE, SIG_IGN);
+  struct sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if(strlen(socketpath) >= sizeof(address.sun_path))
+    {
+      cout<<endl;
+      cout<<"**** ERROR ****"<<endl;
+      cout<<"Socket path too long : "<<socketpath<<endl;
+      cout<<endl;
+      exit(1);
+    }
+  strcpy(address.sun_path, socketpath);
+  unlink(socketpath);
+  LISTENER = socket(AF_UNIX, SOCK_STREAM, 0);
+  if(LISTENER < 0 || bind(LISTENER, (struct sockaddr *) &address, sizeof(address)) < 0
+     || listen(LISTENER, 16) < 0)
+    {
+      cout<<endl;
+      cout<<"**** ERROR ****"<<endl;
+      cout<<"Could not listen on socket : "<<socketpath<<endl;
+      cout<<endl;
+      exit(1);
+    }
+  PATH = socketpath;
+  OUT = NULL;
+}
+
+//Destructor
+RequestStream::~RequestStream()
+{
+  if(LISTENER >= 0)
+    {
+      hangUp();
+      close(LISTENER);
+      unlink(PATH);
+    }
+  else if(IN && IN != stdin)
+    fclose(IN);
+}
+
+//accept
+bool RequestStream::accept()
+{
+  int client = ::accept(LISTENER, NULL, NULL);
+  if(client < 0)
+    return false;
+  IN = fdopen(client, "r");
+  OUT = fdopen(dup(client), "w");
+  return IN && OUT;
+}
+
+//hangUp
+void RequestStream::hangUp()
+{
+  if(IN)
+    fclose(IN);
+  if(OUT)
+    fclose(OUT);
+  IN = NULL;
+  OUT = NULL;
+}
+
+//next
+bool RequestStream::next(REQUEST & request)
+{
+  char * line = NULL;
+  size_t size = 0;
+  bool found = false;
+  while(!found && !QUIT)
+    {
+      if(!IN && (LISTENER < 0 || !accept()))
+	break;
+      ssize_t length = getline(&line, &size, IN);
+      if(length < 0)
+	{
+	  //the list is done, or the client hung up and the next one is awaited
+	  if(LISTENER < 0)
+	    break;
+	  hangUp();
+	  continue;
+	}
+      while(length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r'))
+	line[--length] = 0;
+      if(length == 0 || line[0] == '#')
+	continue;
+      if(!strcmp(line, "quit"))
+	{
+	  QUIT = true;
+	  break;
+	}
+
+      COUNT++;
+      request.TEXT.clear();
+      request.INLINE = !strncmp(line, "begin", 5) && (line[5] == 0 || line[5] == ' ');
+      if(!request.INLINE)
+	{
+	  request.NAME = line;
+	  found = true;
+	  continue;
+	}
+
+      //the lines of an inline instance, up to end
+      request.NAME = line[5] ? string(line + 6) : "instance" + to_string(COUNT);
+      while((length = getline(&line, &size, IN)) >= 0)
+	{
+	  if(!strncmp(line, "end", 3) && (line[3] == '\n' || line[3] == '\r' || line[3] == 0))
+	    break;
+	  request.TEXT.append(line, length);
+	}
+      found = true;
+    }
+  free(line);
+  return found;
+}
+
+//reply
+void RequestStream::reply(const string & line)
+{
+  if(!OUT)
+    return;
+  fputs(line.c_str(), OUT);
+  fputc('\n', OUT);
+  fflush(OUT);
+}
+
+//Zero argument constructor
+Watchdog::Watchdog()
+{
+  STOP = false;
+  DEADLINE = 0;
+  QUIT = false;
+  TIMER = thread(&Watchdog::run, this);
+}
+
+//Destructor
+Watchdog::~Watchdog()
+{
+  {
+    lock_guard <mutex> lock(LOCK);
+    QUIT = true;
+  }
+  CHANGED.notify_all();
+  TIMER.join();
+}
+
+//arm
+void Watchdog::arm(double seconds)
+{
+  lock_guard <mutex> lock(LOCK);
+  STOP = false;
+  DEADLINE = GetTime() + seconds;
+  CHANGED.notify_all();
+}
+
+//disarm
+void Watchdog::disarm()
+{
+  lock_guard <mutex> lock(LOCK);
+  DEADLINE = 0;
+  CHANGED.notify_all();
+}
+
+//run
+void Watchdog::run()
+{
+  unique_lock <mutex> lock(LOCK);
+  while(!QUIT)
+    {
+      if(DEADLINE == 0)
+	CHANGED.wait(lock);
+      else if(GetTime() >= DEADLINE)
+	{
+	  STOP = true;
+	  DEADLINE = 0;
+	}
+      else
+	CHANGED.wait_for(lock, chrono::duration <double> (DEADLINE - GetTime()));
+    }
+}
+
+// End of Code
+//**************************************************************
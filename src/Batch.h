@@ -0,0 +1,118 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Batch.h
+// Description : Contains code for solving many instances in one
+// process. The instances come from a list of files, from the
+// standard input or from the clients of a local socket, and each
+// one is answered by a result line. A watchdog thread stops the
+// search of an instance once its time is up.
+//**************************************************************
+#ifndef BATCH_H
+#define BATCH_H
+
+//Including Libraries and Header files
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+using namespace std;
+
+//REQUEST
+//One instance to solve: the path of its file, or its text when it
+//was sent between a begin and an end line
+struct REQUEST
+{
+  string NAME;
+  string TEXT;
+  bool INLINE;
+};
+
+//**************************************************************
+// RequestStream
+// This class reads the requests, one per line: the path of a file,
+// or begin [name], the lines of the instance and end. Blank lines
+// and lines starting with # are skipped, quit ends the stream. On a
+// socket the clients are served one after the other, each getting
+// the result lines of its requests.
+//
+// Start of Code
+class RequestStream
+{
+  //public variables and functions
+public:
+  //Two argument constructor : reads the list file, - for the standard
+  //                           input, or listens on the socket path if
+  //                           the list is NULL
+  RequestStream(const char * list, const char * socketpath);
+  //Destructor
+  ~RequestStream();
+  //next : reads the next request, waiting for the next client on a
+  //       socket; returns false once there is none
+  bool next(REQUEST & request);
+  //reply : sends a result line to whoever sent the last request
+  void reply(const string & line);
+  //private variables and functions
+private:
+  //IN = the stream the requests are read from, NULL between two clients
+  //OUT = the stream the result lines are written to
+  //LISTENER = the listening socket, -1 if none
+  //PATH = the path of the socket, removed at the end
+  //COUNT = number of requests read, to name the inline ones
+  //QUIT = true once quit was read
+  FILE * IN;
+  FILE * OUT;
+  int LISTENER;
+  const char * PATH;
+  int COUNT;
+  bool QUIT;
+  //accept : waits for the next client of the socket
+  bool accept();
+  //hangUp : closes the streams of the client
+  void hangUp();
+};
+// End of Code
+//
+
+//**************************************************************
+// Watchdog
+// This class sets STOP once the time given to arm has passed, unless
+// disarm comes first. One thread serves all the instances.
+//
+// Start of Code
+class Watchdog
+{
+  //public variables and functions
+public:
+  //Zero argument constructor : starts the thread, disarmed
+  Watchdog();
+  //Destructor : stops the thread
+  ~Watchdog();
+  //arm : clears STOP and sets it again in seconds seconds
+  void arm(double seconds);
+  //disarm : STOP is not set any more
+  void disarm();
+  //STOP = the flag the searches check
+  atomic<bool> STOP;
+  //private variables
+private:
+  //LOCK, CHANGED = guard and signal the deadline
+  //DEADLINE = the time STOP is set at, 0 if disarmed
+  //QUIT = true once the thread must end
+  //TIMER = the thread
+  mutex LOCK;
+  condition_variable CHANGED;
+  double DEADLINE;
+  bool QUIT;
+  thread TIMER;
+  //run : the loop of the thread
+  void run();
+};
+// End of Code
+//
+#endif
+//**************************************************************
@@ -6,71 +6,104 @@
 //**************************************************************
 
 //Including Libraries and Header Files
+#include <algorithm>
 #include "Clause.h"
 #include "Literal.h"
 using namespace std;
 //**************************************************************
 //Start of Code
 
-//Zero Argument Constructor
-Clause::Clause()
-{
-  ATOM_LIST.reserve(5);
-  SAT = false;
-  NumAtom = 0;
-  NumUnAss = 0;
-  LEVEL = -1;
-  WATCHED.reserve(2);
-  W1 = 0;
-  W2 = -1;
-
-  ATOM_LIST_MODIF.reserve(5);
+//Size of the blocks of the arena, in literals
+#define ARENABLOCK (1 << 20)
 
+//ClauseArena Zero argument constructor
+ClauseArena::ClauseArena()
+{
+  USED = 0;
+  CAPACITY = 0;
+  SIZE = 0;
+  WASTED = 0;
+  RESERVED = 0;
 }
 
-//One Argument Constructor
-Clause::Clause(int size)
+//ClauseArena Destructor
+ClauseArena::~ClauseArena()
 {
-  ATOM_LIST.reserve(size);
-  SAT = false;
-  NumAtom = 0;
-  NumUnAss = 0;
-  LEVEL = -1;
-  WATCHED.reserve(2);
-  W1 = 0;
-  W2 = -1;
-
-
-  ATOM_LIST_MODIF.reserve(size);
-
+  for(unsigned int i=0; i<BLOCKS.size(); i++)
+    delete [] BLOCKS[i];
 }
 
-//Destructor
-Clause::~Clause()
+//alloc
+LIT * ClauseArena::alloc(int size)
 {
-  ATOM_LIST.clear();
+  //start a new block if the clause does not fit in the last one
+  if(BLOCKS.empty() || USED + size > CAPACITY)
+    {
+      //a block kept by reset is replaced if the clause does not fit in it
+      if(!BLOCKS.empty() && USED == 0)
+	{
+	  delete [] BLOCKS.back();
+	  BLOCKS.pop_back();
+	  RESERVED -= CAPACITY;
+	}
+      CAPACITY = (size > ARENABLOCK ? size : ARENABLOCK);
+      RESERVED += CAPACITY;
+      BLOCKS.push_back(new LIT[CAPACITY]);
+      USED = 0;
+    }
+  LIT * atoms = BLOCKS.back() + USED;
+  USED += size;
+  SIZE += size;
+  return atoms;
 }
 
-//AddAtom
-void Clause::addAtom(Literal * atom)
+//swap
+void ClauseArena::swap(ClauseArena & other)
 {
-  ATOM_LIST.push_back(atom);
-  NumAtom++;
-  NumUnAss++;
+  BLOCKS.swap(other.BLOCKS);
+  std::swap(USED, other.USED);
+  std::swap(CAPACITY, other.CAPACITY);
+  std::swap(SIZE, other.SIZE);
+  std::swap(WASTED, other.WASTED);
+  std::swap(RESERVED, other.RESERVED);
 }
 
-
-void Clause::addAtomModif(Literal * atom)
+//reset
+void ClauseArena::reset()
 {
-  for ( int i = 0; i < ATOM_LIST_MODIF.size(); i++ ) {
+  if(BLOCKS.empty())
+    return;
+  for(unsigned int i=0; i+1<BLOCKS.size(); i++)
+    delete [] BLOCKS[i];
+  BLOCKS[0] = BLOCKS.back();
+  BLOCKS.resize(1);
+  USED = 0;
+  SIZE = 0;
+  WASTED = 0;
+  RESERVED = CAPACITY;
+}
 
-	  if ( atom -> VAR ==  ATOM_LIST_MODIF[i][0] -> VAR ) {
-		  ATOM_LIST_MODIF[i][1]= atom;
-	  }
+//Two Argument Constructor
+Clause::Clause(LIT * atoms, int size)
+{
+  ATOM_LIST = atoms;
+  SAT = false;
+  NumAtom = size;
+  NumUnAss = size;
+  LEVEL = -1;
+  LBD = 0;
+  ACTIVITY = 0;
+  IMPORTED = false;
+  USED = false;
+  WATCHED[0] = NOLIT;
+  WATCHED[1] = NOLIT;
+  W1 = 0;
+  W2 = -1;
+}
 
-  }
-  NumAtom++;
-  NumUnAss++;
+//Destructor
+Clause::~Clause()
+{
 }
 
 //Print
@@ -78,7 +111,7 @@ void Clause::Print()
 {
   for(int i=0; i<NumAtom; i++)
     {
-      ATOM_LIST[i]->Print();
+      printLit(ATOM_LIST[i]);
       // cout<<" ";
     }
   cout<<endl;
@@ -86,7 +119,7 @@ void Clause::Print()
 
 //Accessor functions
 //getAtom
-inline Literal * Clause::getAtom(int index)
+inline LIT Clause::getAtom(int index)
 {
   return ATOM_LIST[index];
 }
@@ -25,6 +25,53 @@
 
 using namespace std;
 //**************************************************************
+// ClauseArena
+// This class stores the literals of all the clauses of a formula
+// one after the other. Memory is taken in large blocks that never
+// move, so a clause can point straight at its literals
+//
+// Start of Code
+class ClauseArena
+{
+  //public variables and functions
+public:
+  //Zero argument constructor
+  ClauseArena();
+  //Destructor
+  ~ClauseArena();
+  //alloc : returns room for size literals
+  LIT * alloc(int size);
+  //release : records that size literals of a deleted clause are not used any more
+  void release(int size) { WASTED += size; }
+  //size : number of literals handed out so far
+  long size() const { return SIZE; }
+  //wasted : number of literals handed out for clauses deleted since
+  long wasted() const { return WASTED; }
+  //reserved : number of literals the blocks taken so far can hold
+  long reserved() const { return RESERVED; }
+  //swap : exchanges the memory of two arenas
+  void swap(ClauseArena & other);
+  //reset : forgets all the literals handed out, keeping the last block
+  //        to hand out again
+  void reset();
+  //private variables
+private:
+  //BLOCKS = the blocks of memory taken so far
+  //USED = number of literals handed out from the last block
+  //CAPACITY = size of the last block
+  //SIZE = number of literals handed out from all blocks
+  //WASTED = number of literals released
+  //RESERVED = number of literals all blocks can hold
+  vector <LIT *> BLOCKS;
+  int USED;
+  int CAPACITY;
+  long SIZE;
+  long WASTED;
+  long RESERVED;
+};
+// End of Code
+//
+
 // Clause
 // This class represents the Clause object which stores the atoms
 // in the clause. It also stores number of atoms in the clause,
@@ -36,40 +83,44 @@ class Clause
 {
   //public variables and functions
 public:
-  //ATOM_LIST = vector of atoms
+  //ATOM_LIST = array of the atoms, in an arena of the formula
   //SAT = boolean variable true if clause satisfied else false
   //NumAtom = number of atoms in the clause
   //NumUnAss = number of unassigned literals in the clause
   //LEVEL = Level at which the clause got satisfied, default -1
-  vector <Literal *> ATOM_LIST;
-  vector <Literal **> ATOM_LIST_MODIF;
-
-
+  //LBD = number of different decision levels of the atoms of a learned
+  //      clause when it was learned, 0 for the clauses of the input
+  //ACTIVITY = score of a learned clause, bumped when it is the reason
+  //           of a literal resolved while analyzing a conflict
+  //IMPORTED = true for a clause learned by another search of the portfolio
+  //USED = true once an imported clause took part in a conflict analysis
+  //The fields are ordered by size so that the object has no padding
+  LIT * ATOM_LIST;
+  double ACTIVITY;
 
-  bool SAT;
   int NumAtom;
   int NumUnAss;
   int LEVEL;
-  //Watched Literals:
-  vector <Literal *> WATCHED;
+  int LBD;
+  //Watched Literals, NOLIT if the clause has a single literal:
+  LIT WATCHED[2];
   // use indexes instead lists for watched literals:
   int W1;
   int W2;
+  bool SAT;
+  bool IMPORTED;
+  bool USED;
 
-  //Zero Argument Constructor
-  Clause();
-  //One Argument Constructor
-  Clause(int size);
+  //Two Argument Constructor : clause over size atoms already stored at atoms
+  Clause(LIT * atoms, int size);
   //Destructor
   ~Clause();
-  //AddAtom : adds an literal to clause
-  void addAtom(Literal * atom);
   //Print : function to print the clause
   void Print();
 
   //Accessor functions
   //getAtom : returns atom at index
-  Literal * getAtom(int index);
+  LIT getAtom(int index);
   //getSAT : returns the SAT value
   bool getSAT();
   //setSAT : sets SAT value
@@ -90,13 +141,6 @@ public:
   bool isUnit();
   //isEmpty : returns true if NumUnAss == 0
   bool isEmpty();
-
-  //hasAtom
-   bool ClauseisEqual(Clause * clause1, Clause * clause2);
-  bool LitisEqual(Literal * literal1, Literal * literal2);
-
-  void addAtomModif(Literal * atom);
- //bool HasAtom(Literal * atom);
 };
 // End of Code
 //
@@ -0,0 +1,57 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Constraint.h
+// Description : Contains the interface of the constraints over
+// variables that the search propagates besides the clauses. Each
+// value a constraint takes away, and each conflict it finds, comes
+// with a clause explaining it, which the search learns.
+//**************************************************************
+#ifndef CONSTRAINT_H
+#define CONSTRAINT_H
+
+//Including Libraries and Header files
+#include <vector>
+
+#include "Literal.h"
+#include "Variable.h"
+
+using namespace std;
+
+//**************************************************************
+// Constraint
+// This class is the interface of a constraint over variables. The
+// search calls propagate once some of its variables lost values,
+// and undo when it backtracks, with positions in its trail of the
+// atoms assigned.
+//
+// Start of Code
+class Constraint
+{
+  //public variables and functions
+public:
+  //Destructor
+  virtual ~Constraint() {}
+  //VARS = the variables of the constraint
+  vector <int> VARS;
+  //propagate : adds to atoms and sizes a clause for each value that must be
+  //            taken from a variable, its first atom the one taken away and
+  //            the others falsified; returns false if the constraint cannot
+  //            hold, the clauses are then the falsified one explaining it.
+  //            time is the number of atoms of the trail assigned so far
+  virtual bool propagate(const vector <Variable *> & varlist, int time, vector <LIT> & atoms, vector <int> & sizes) = 0;
+  //undo : forgets what was propagated once the atoms of the trail from stop
+  //       on were assigned
+  virtual void undo(int) {}
+  //holds : returns true if the values of the variables satisfy the constraint
+  virtual bool holds(const vector <Variable *> & varlist) const = 0;
+  //decompose : adds to atoms and sizes the clauses that say the same
+  virtual void decompose(const vector <Variable *> & varlist, vector <LIT> & atoms, vector <int> & sizes) const = 0;
+  //clone : returns the constraint, with nothing propagated yet
+  virtual Constraint * clone(const vector <Variable *> & varlist) const = 0;
+};
+// End of Code
+//
+#endif
+//**************************************************************
@@ -0,0 +1,328 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Cube.cc
+//**************************************************************
+
+//Including Libraries and Header Files
+#include "Cube.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+#include <climits>
+using namespace std;
+//**************************************************************
+//Start of Code
+
+//Number of variables, those in the most unsatisfied clauses, whose
+//values the lookahead tries at each split
+#define LOOKAHEADVARS 16
+//Number of clauses each worker can share before it overwrites the oldest
+#define SHARECAPACITY 4096
+
+//SPLIT
+//Outcome of the lookahead splitting
+struct SPLIT
+{
+  vector < vector <LIT> > CUBES;
+  int NODES;
+  int REFUTED;
+};
+
+//CONQUER
+//State shared by the workers solving the cubes
+struct CONQUER
+{
+  mutex LOCK;
+  condition_variable CHANGED;
+  atomic<bool> STOP;
+  atomic<int> NEXT;
+  atomic<int> REFUTED;
+  int RUNNING;
+  int WINNER;
+  int RESULT;
+};
+
+//chooseSplit
+//Finds the variable to split on by lookahead and puts in values its
+//values whose consequences have no conflict. Returns -1 if every
+//variable is assigned
+static int chooseSplit(Formula * formula, vector <int> & values)
+{
+  //the variables with the most occurrences in unsatisfied clauses are tried
+  vector < pair <int, int> > candidates;
+  for(unsigned int i = 1; i < formula->VARLIST.size(); i++)
+    {
+      Variable * var = formula->VARLIST[i];
+      if(var->SAT)
+	continue;
+      int count = 0;
+      for(int j = 0; j < var->DOMAINSIZE; j++)
+	if(var->ATOMASSIGN[j] == 0)
+	  count += var->ATOMCNTPOS[j] + var->ATOMCNTNEG[j];
+      candidates.push_back(make_pair(-count, (int) i));
+    }
+  if(candidates.empty())
+    return -1;
+  int tried = min((int) candidates.size(), LOOKAHEADVARS);
+  partial_sort(candidates.begin(), candidates.begin() + tried, candidates.end());
+
+  //the variable whose weakest value satisfies the most clauses wins,
+  //fewer values break the ties as they make fewer cubes
+  int best = -1;
+  int bestscore = -1;
+  vector <int> survivors;
+  for(int c = 0; c < tried; c++)
+    {
+      int i = candidates[c].second;
+      Variable * var = formula->VARLIST[i];
+      int score = INT_MAX;
+      survivors.clear();
+      for(int j = 0; j < var->DOMAINSIZE; j++)
+	if(var->ATOMASSIGN[j] == 0)
+	  {
+	    int reduced = formula->probe(makeLit(i, true, j));
+	    if(reduced < 0)
+	      continue;
+	    survivors.push_back(j);
+	    score = min(score, reduced);
+	  }
+
+      //a variable with one value left or none is decided by the lookahead
+      if(survivors.size() <= 1)
+	{
+	  values = survivors;
+	  return i;
+	}
+      if(best < 0 || score > bestscore
+	 || (score == bestscore && survivors.size() < values.size()))
+	{
+	  best = i;
+	  bestscore = score;
+	  values = survivors;
+	}
+    }
+  return best;
+}
+
+//split
+//Adds the cubes below the current assignment of the splitter, after at
+//most depth more splits; a value forced by the lookahead is no split
+static void split(Formula * splitter, int depth, vector <LIT> & cube, SPLIT & out)
+{
+  out.NODES++;
+  vector <int> values;
+  int var = -1;
+  if(depth > 0 && splitter->UNSATCLAUSES > 0)
+    var = chooseSplit(splitter, values);
+  if(var < 0)
+    {
+      out.CUBES.push_back(cube);
+      return;
+    }
+  if(values.empty())
+    {
+      out.REFUTED++;
+      return;
+    }
+
+  for(unsigned int v = 0; v < values.size(); v++)
+    {
+      LIT atom = makeLit(var, true, values[v]);
+      splitter->LEVEL++;
+      splitter->UNITCLAUSE = -1;
+      splitter->reduceTheory(var, true, values[v]);
+      if(!splitter->CONFLICT)
+	splitter->unitPropagation();
+      if(!splitter->CONFLICT)
+	{
+	  cube.push_back(atom);
+	  split(splitter, values.size() > 1 ? depth - 1 : depth, cube, out);
+	  cube.pop_back();
+	}
+      else
+	out.REFUTED++;
+      splitter->CONFLICT = false;
+      splitter->UNITLIST.clear();
+      splitter->LEVEL--;
+      splitter->undoTheory(splitter->LEVEL);
+    }
+}
+
+//search
+//Runs the search of formula under its assumptions
+static int search(Formula * formula)
+{
+  if(formula->WATCH)
+    return formula->WatchedLiterals();
+  return formula->NonChronoBacktrack();
+}
+
+//SolveCubes
+int SolveCubes(Formula * master, CommandLine * cline,
+	       Formula * & winner, string & report)
+{
+  double start = master->TIME_S;
+  int timelimit = master->TIMELIMIT;
+  vector < vector <LIT> > cubes;
+  char line[256];
+  winner = master;
+
+  if(cline->CUBEIN)
+    {
+      if(!master->readCubes(cline->CUBEIN, cubes))
+	return INPUTERROR;
+      snprintf(line, sizeof(line), "Cubes       : %d read from %s\n", (int) cubes.size(), cline->CUBEIN);
+      report = line;
+    }
+  else
+    {
+      //the lookahead uses the counting engine, on a copy of master
+      Formula splitter(cline);
+      splitter.LOG = false;
+      splitter.WATCH = false;
+      splitter.CMV = false;
+      splitter.EVSIDS = false;
+      splitter.shareClauses(master);
+
+      SPLIT out;
+      out.NODES = 0;
+      out.REFUTED = 0;
+      vector <LIT> cube;
+      splitter.checkUnit();
+      splitter.unitPropagation();
+      if(splitter.CONFLICT)
+	out.REFUTED++;
+      else
+	split(&splitter, cline->CUBEDEPTH, cube, out);
+      cubes.swap(out.CUBES);
+      snprintf(line, sizeof(line), "Cubes       : %d at depth %d, %d nodes, %d refuted by the lookahead in %2.4f\n",
+	       (int) cubes.size(), cline->CUBEDEPTH, out.NODES, out.REFUTED, GetTime() - start);
+      report = line;
+    }
+
+  if(cline->CUBEOUT)
+    {
+      master->writeCubes(cline->CUBEOUT, cubes);
+      report += "Cubes written to " + string(cline->CUBEOUT) + "\n";
+      master->TIME_E = GetTime();
+      return cubes.empty() ? 2 : CUBESWRITTEN;
+    }
+  if(cubes.empty())
+    {
+      master->TIME_E = GetTime();
+      return 2;
+    }
+
+  //no more workers than cubes
+  int threads = cline->THREADS > 0 ? cline->THREADS : thread::hardware_concurrency();
+  threads = max(1, min(threads, (int) cubes.size()));
+
+  CONQUER shared;
+  shared.STOP = false;
+  shared.NEXT = 0;
+  shared.REFUTED = 0;
+  shared.RUNNING = threads;
+  shared.WINNER = -1;
+  shared.RESULT = 1;
+
+  //the learned clauses hold without the cubes, so the workers share them
+  ClauseExchange exchange(threads, SHARECAPACITY);
+
+  vector <Formula *> formulas(threads, (Formula *) NULL);
+  vector <int> solved(threads, 0);
+  vector <thread> workers;
+  for(int i = 0; i < threads; i++)
+    {
+      formulas[i] = new Formula(cline);
+      formulas[i]->LOG = false;
+      //the engines with assumptions are the counting and the watched literal ones
+      formulas[i]->WATCH = master->WATCH || master->CMV;
+      formulas[i]->CMV = false;
+      formulas[i]->STOP = &shared.STOP;
+      formulas[i]->EXCHANGE = &exchange;
+      formulas[i]->SHAREID = i;
+      formulas[i]->SHARESIZE = cline->SHARESIZE;
+      formulas[i]->SHARELBD = cline->SHARELBD;
+
+      workers.push_back(thread([&, i]()
+	{
+	  Formula * formula = formulas[i];
+	  formula->shareClauses(master);
+	  formula->TIME_S = start;
+
+	  //the workers take the next cube until none is left, a cube
+	  //falsified under its assumptions only closes that cube
+	  while(!shared.STOP)
+	    {
+	      int c = shared.NEXT++;
+	      if(c >= (int) cubes.size())
+		break;
+	      formula->ASSUMPTIONS = cubes[c];
+	      //each cube starts at the level 0, where the clauses of the others come in
+	      formula->importClauses();
+	      int result = search(formula);
+	      if(result == 2 && formula->FAILEDASSUMPTION)
+		{
+		  solved[i]++;
+		  shared.REFUTED++;
+		  formula->resetSearch();
+		  continue;
+		}
+
+	      //a model, or a conflict without assumptions, answers for all cubes
+	      unique_lock <mutex> lock(shared.LOCK);
+	      if(result != 1 && shared.WINNER < 0)
+		{
+		  solved[i]++;
+		  shared.WINNER = i;
+		  shared.RESULT = result;
+		  shared.STOP = true;
+		}
+	      break;
+	    }
+
+	  unique_lock <mutex> lock(shared.LOCK);
+	  shared.RUNNING--;
+	  shared.CHANGED.notify_all();
+	}));
+    }
+
+  //stop the workers at the time limit, all at once rather than each
+  //at its next reading of the clock
+  {
+    unique_lock <mutex> lock(shared.LOCK);
+    chrono::duration <double> limit(start + timelimit - GetTime());
+    if(!shared.CHANGED.wait_for(lock, limit, [&]() { return shared.WINNER >= 0 || shared.RUNNING == 0; }))
+      shared.STOP = true;
+  }
+  for(unsigned int i = 0; i < workers.size(); i++)
+    workers[i].join();
+
+  int result = shared.RESULT;
+  if(shared.WINNER < 0 && shared.REFUTED == (int) cubes.size())
+    result = 2;
+  winner = formulas[shared.WINNER >= 0 ? shared.WINNER : 0];
+
+  //what each worker did
+  report += "\nWorker  Cubes  Decisions  Exported  Imported  Used\n";
+  for(int i = 0; i < threads; i++)
+    {
+      snprintf(line, sizeof(line), "%6d %6d %10d %9d %9d %5d%s\n", i, solved[i], formulas[i]->DECISIONS,
+	       formulas[i]->EXPORTED, formulas[i]->IMPORTED, formulas[i]->USEDIMPORTS,
+	       i == shared.WINNER ? "  (winner)" : "");
+      report += line;
+    }
+  //the other copies are not needed any more
+  for(int i = 0; i < threads; i++)
+    if(formulas[i] != winner)
+      delete formulas[i];
+  winner->TIME_E = GetTime();
+  return result;
+}
+
+// End of Code
+//**************************************************************
@@ -0,0 +1,40 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Cube.h
+// Description : Contains code for cube and conquer. A lookahead
+// splits the formula into cubes, branching on all the values of a
+// variable at each split, and worker threads solve the cubes as
+// assumptions of their searches. The cubes can be written to a
+// file and read back, so they can be shared out between processes.
+//**************************************************************
+#ifndef CUBE_H
+#define CUBE_H
+
+//Including Libraries and Header files
+#include <string>
+
+#include "Global.h"
+#include "Formula.h"
+
+using namespace std;
+
+//Result of SolveCubes when the cubes were written, not solved
+#define CUBESWRITTEN 3
+
+//**************************************************************
+//SolveCubes
+//Splits master to the depth of the command line, or reads the cubes
+//of its cube file, then either writes them to the cube output file
+//and returns CUBESWRITTEN, or solves them on worker threads that
+//search copies of master. Returns 0 if a cube is satisfiable, 2 if
+//all of them are not, 1 on timeout, INPUTERROR if the cube file
+//cannot be read; sets winner to the formula to report on and report
+//to what the splitting and the workers did. The copies are deleted,
+//but winner, so winner is master or a copy the caller deletes before
+//master
+int SolveCubes(Formula * master, CommandLine * cline,
+	       Formula * & winner, string & report);
+#endif
+//**************************************************************
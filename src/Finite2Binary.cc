@@ -0,0 +1,30 @@
+//**********************************************************************//
+//Including Libraries and Header files
+#include "Global.h"
+#include "Formula.h"
+#include <cstring>
+
+
+using namespace std;
+
+//**********************************************************************//
+//Function Definitions
+//Finite2Binary
+//Reads a finite domain file with the parser of the solver and writes
+//it in the binary format, which -solvenc and -solvech load directly
+void Finite2Binary(CommandLine * cline)
+{
+  //local variables
+  Formula * fobj = new Formula(cline);
+
+  if(!fobj->BuildFormula(cline))
+    exit(1);
+  //the format has clauses only
+  fobj->decomposeConstraints();
+  fobj->writeBinary(cline->MODEL_FILE);
+  cout<<"Wrote "<<fobj->VARLIST.size() - 1<<" variables and "
+      <<fobj->ORIGINALCLAUSES<<" clauses"<<endl;
+  delete fobj;
+}
+//End Finite2Binary
+//**********************************************************************//
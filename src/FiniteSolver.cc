@@ -0,0 +1,160 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : FiniteSolver.cc
+//**************************************************************
+
+//Including Libraries and Header Files
+#include "FiniteSolver.h"
+#include <cstring>
+#include <algorithm>
+using namespace std;
+//**************************************************************
+//Start of Code
+
+//Default constructor
+FiniteSolver::FiniteSolver()
+{
+  FORMULA = new Formula();
+  init();
+}
+
+//One argument constructor
+FiniteSolver::FiniteSolver(CommandLine * cline)
+{
+  FORMULA = new Formula(cline);
+  init();
+}
+
+//Destructor
+FiniteSolver::~FiniteSolver()
+{
+  delete FORMULA;
+}
+
+//init
+void FiniteSolver::init()
+{
+  //the variable 0 is never used, as in a file
+  FORMULA->VARLIST.push_back(new Variable(0, 0));
+  FORMULA->VARLIST[0]->SAT = true;
+  STARTED = false;
+  UNSAT = false;
+}
+
+//added
+bool FiniteSolver::added(LIT atom) const
+{
+  int var = litVar(atom);
+  return var >= 1 && var < (int) FORMULA->VARLIST.size()
+    && (int) litVal(atom) < FORMULA->VARLIST[var]->DOMAINSIZE;
+}
+
+//addVariable
+int FiniteSolver::addVariable(int domainsize)
+{
+  if(domainsize < 1 || domainsize > (1 << LITVALBITS))
+    return -1;
+  if(STARTED)
+    FORMULA->addVariable(domainsize);
+  else
+    FORMULA->VARLIST.push_back(new Variable(FORMULA->VARLIST.size(), domainsize));
+  return FORMULA->VARLIST.size() - 1;
+}
+
+//addClause
+bool FiniteSolver::addClause(const vector <LIT> & atoms)
+{
+  for(unsigned int i = 0; i < atoms.size(); i++)
+    if(!added(atoms[i]))
+      return false;
+  //the empty clause is never satisfied, nor passed to the engines
+  if(atoms.empty())
+    UNSAT = true;
+  else
+    {
+      //the engines count the atoms of a clause, so each one is kept once
+      int size = 0;
+      for(unsigned int i = 0; i < atoms.size(); i++)
+	if(find(PENDINGATOMS.end() - size, PENDINGATOMS.end(), atoms[i]) == PENDINGATOMS.end())
+	  {
+	    PENDINGATOMS.push_back(atoms[i]);
+	    size++;
+	  }
+      PENDINGSIZES.push_back(size);
+    }
+  return true;
+}
+
+//solve
+int FiniteSolver::solve(const vector <LIT> & assumptions)
+{
+  for(unsigned int i = 0; i < assumptions.size(); i++)
+    if(!added(assumptions[i]))
+      return INPUTERROR;
+
+  //the engines with assumptions are the counting and the watched literal ones
+  FORMULA->CMV = false;
+  FORMULA->FAILEDASSUMPTION = false;
+  if(UNSAT)
+    return 2;
+
+  if(!STARTED)
+    {
+      //the first clauses are the input, stored as if read from a file
+      const LIT * atoms = PENDINGATOMS.empty() ? NULL : &PENDINGATOMS[0];
+      for(unsigned int k = 0; k < PENDINGSIZES.size(); atoms += PENDINGSIZES[k++])
+	{
+	  LIT * stored = FORMULA->INPUTARENA.alloc(PENDINGSIZES[k]);
+	  memcpy(stored, atoms, PENDINGSIZES[k] * sizeof(LIT));
+	  FORMULA->addInputClause(stored, PENDINGSIZES[k]);
+	}
+      FORMULA->finishFormula();
+      STARTED = true;
+    }
+  else
+    {
+      FORMULA->resetSearch();
+      FORMULA->addRootClauses(PENDINGATOMS, PENDINGSIZES);
+    }
+  PENDINGATOMS.clear();
+  PENDINGSIZES.clear();
+
+  FORMULA->ASSUMPTIONS = assumptions;
+  FORMULA->TIME_S = GetTime();
+  int result;
+  if(FORMULA->WATCH)
+    result = FORMULA->WatchedLiterals();
+  else
+    result = FORMULA->NonChronoBacktrack();
+  FORMULA->TIME_E = GetTime();
+
+  if(result == 2 && !FORMULA->FAILEDASSUMPTION)
+    UNSAT = true;
+  return result;
+}
+
+//value
+int FiniteSolver::value(int var) const
+{
+  if(var < 1 || var >= (int) FORMULA->VARLIST.size())
+    return -1;
+  //a variable left unassigned by the model may take any value not excluded
+  Variable * v = FORMULA->VARLIST[var];
+  if(v->VAL >= 0)
+    return v->VAL;
+  for(int j = 0; j < v->DOMAINSIZE; j++)
+    if(v->ATOMASSIGN[j] >= 0)
+      return j;
+  return 0;
+}
+
+//failed
+bool FiniteSolver::failed() const
+{
+  return FORMULA->FAILEDASSUMPTION;
+}
+
+// End of Code
+//**************************************************************
@@ -0,0 +1,82 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : FiniteSolver.h
+// Description : Contains code for using the solver as a library.
+// The variables and clauses are added through calls instead of a
+// file, and the formula can be solved again and again, under other
+// assumptions or after more clauses and variables are added, with
+// the learned clauses and the activities of the searches before.
+//**************************************************************
+#ifndef FINITESOLVER_H
+#define FINITESOLVER_H
+
+//Including Libraries and Header files
+#include <vector>
+
+#include "Global.h"
+#include "Formula.h"
+
+using namespace std;
+
+//**************************************************************
+// FiniteSolver
+// This class owns a formula and runs the counting engine, or the
+// watched literal one when WATCH is set, on it. The clauses added
+// between two solves are attached at the level 0 of the search
+// before, so nothing it learned is lost. The literals are those of
+// makeLit, over the variables numbered from 1 by addVariable. A call
+// with a wrong argument prints nothing and changes nothing, it only
+// returns the error value given below.
+//
+// Start of Code
+class FiniteSolver
+{
+  //public variables and functions
+public:
+  //Default constructor : an empty formula with the default options
+  FiniteSolver();
+  //One argument constructor : an empty formula with the options of cline
+  FiniteSolver(CommandLine * cline);
+  //Destructor
+  ~FiniteSolver();
+  //addVariable : adds a variable with the values 0..domainsize-1 and
+  //              returns its number, -1 if domainsize is out of range
+  int addVariable(int domainsize);
+  //addClause : adds the clause made of the atoms; returns false if an
+  //            atom is not over a variable and a value added
+  bool addClause(const vector <LIT> & atoms);
+  //solve : searches for a model in which the assumptions hold; returns
+  //        0 if sat, 1 if timeout, 2 if unsat, INPUTERROR if an assumption
+  //        is not over a variable and a value added
+  int solve(const vector <LIT> & assumptions = vector <LIT>());
+  //value : returns the value of the variable in the model of the last solve,
+  //        -1 if the variable was not added
+  int value(int var) const;
+  //failed : returns true if the last solve was unsat only because of its
+  //         assumptions, so the formula itself may still be sat
+  bool failed() const;
+  //formula : returns the formula, whose options can be set before the first solve
+  Formula * formula() { return FORMULA; }
+  //private variables and functions
+private:
+  //FORMULA = the formula searched
+  //STARTED = true once the formula was searched
+  //UNSAT = true once the formula is unsat without assumptions
+  //PENDINGATOMS = the atoms of the clauses added since the last solve
+  //PENDINGSIZES = the size of each of these clauses
+  Formula * FORMULA;
+  bool STARTED;
+  bool UNSAT;
+  vector <LIT> PENDINGATOMS;
+  vector <int> PENDINGSIZES;
+  //init : sets up the empty formula
+  void init();
+  //added : returns true if the atom is over a variable and a value added
+  bool added(LIT atom) const;
+};
+// End of Code
+//
+#endif
+//**************************************************************
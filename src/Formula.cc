@@ -8,10 +8,31 @@
 //Including Libraries and Header files
 #include "Formula.h"
 #include "Clause.h"
+#include "Subsumption.h"
 #include <cstring>
 #include <stdexcept>
 #include <climits>
+#include <cctype>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 using namespace std;
+
+//Number of learned clauses kept before the first reduction of the clause database,
+//and by how much this limit grows after each reduction
+#define REDUCEFIRST 2000
+#define REDUCEINC 300
+//Decay of the activity of the learned clauses, and the activity above which all
+//of them are scaled down
+#define CLAUSEDECAY 0.999
+#define CLAUSERESCALE 1e20
+//Number of steps of a search between two readings of the clock and of the memory
+#define LIMITPERIOD 128
+//Number of tuples of the domains up to which a forbidden table is turned into
+//the table of the tuples allowed, beyond it into a clause for each tuple
+#define TABLELIMIT (1 << 16)
 //**********************************************************************//
 //Default 0-arg constructor
 Formula::Formula () {
@@ -19,6 +40,8 @@ Formula::Formula () {
 	VARLIST.reserve(10);
 	CLAUSELIST.reserve(10);
 	TIMELIMIT = 3600; //1hour = 60mins * 60secs
+	MEMLIMIT = 0;
+	LIMITCOUNT = 0;
 	TIME_S = 0;
 	TIME_E = 0;
 	LEVEL = 0;
@@ -29,12 +52,43 @@ Formula::Formula () {
 	UNITCLAUSE = -1;
 	CONFLICT = false;
 	CONFLICTINGCLAUSE = -1;
+	UNSATCLAUSES = 0;
+	DECIDEFROM = 0;
+	SEENSTAMP = 0;
+	ORIGINALCLAUSES = 0;
+	LEARNEDCLAUSES = 0;
+	DELETEDCLAUSES = 0;
+	NEXTREDUCE = REDUCEFIRST;
+	CLAUSEINC = 1.0;
 	DECSTACK.reserve(10);
 	RESTARTS = 0;
 	LOG = false;
 	WATCH = false;
 	CMV = false;
 	VSIDS=false;
+	EVSIDS = false;
+	PHASE = false;
+	SUBSUME = false;
+	SUBSUMELEARNED = false;
+	SEED = 0;
+	STOP = NULL;
+	EXCHANGE = NULL;
+	SHAREID = 0;
+	SHARESIZE = 0;
+	SHARELBD = 0;
+	EXPORTED = 0;
+	IMPORTED = 0;
+	USEDIMPORTS = 0;
+	FAILEDASSUMPTION = false;
+	TASKS = NULL;
+	DONATED = 0;
+	CONSTRAINTTRAIL = 0;
+	EXPLAINED = 0;
+	SUBSUMEDAT = 0;
+	DUPLICATES = 0;
+	SUBSUMED = 0;
+	STRENGTHENED = 0;
+	TAUTOLOGIES = 0;
 }
 
 //1-arg constructor
@@ -43,6 +97,8 @@ Formula::Formula ( CommandLine * cline ) {
 	VARLIST.reserve(10);
 	CLAUSELIST.reserve(10);
 	TIMELIMIT = cline->TIME;
+	MEMLIMIT = cline->MEM;
+	LIMITCOUNT = 0;
 	TIME_S = 0;
 	TIME_E = 0;
 	LEVEL = 0;
@@ -53,200 +109,837 @@ Formula::Formula ( CommandLine * cline ) {
 	UNITCLAUSE = -1;
 	CONFLICT = false;
 	CONFLICTINGCLAUSE = -1;
+	UNSATCLAUSES = 0;
+	DECIDEFROM = 0;
+	SEENSTAMP = 0;
+	ORIGINALCLAUSES = 0;
+	LEARNEDCLAUSES = 0;
+	DELETEDCLAUSES = 0;
+	NEXTREDUCE = REDUCEFIRST;
+	CLAUSEINC = 1.0;
 	DECSTACK.reserve(10);
 	RESTARTS = 0;
 	LOG = cline->LOG;
 	WATCH = cline->WATCH;
 	CMV =  cline->CMV;
 	VSIDS = cline->VSIDS;
+	EVSIDS = cline->EVSIDS;
+	PHASE = cline->PHASE;
+	SUBSUME = cline->SUBSUME;
+	SUBSUMELEARNED = cline->SUBSUMELEARNED;
+	SEED = 0;
+	STOP = NULL;
+	EXCHANGE = NULL;
+	SHAREID = 0;
+	SHARESIZE = 0;
+	SHARELBD = 0;
+	EXPORTED = 0;
+	IMPORTED = 0;
+	USEDIMPORTS = 0;
+	FAILEDASSUMPTION = false;
+	TASKS = NULL;
+	DONATED = 0;
+	CONSTRAINTTRAIL = 0;
+	EXPLAINED = 0;
+	SUBSUMEDAT = 0;
+	DUPLICATES = 0;
+	SUBSUMED = 0;
+	STRENGTHENED = 0;
+	TAUTOLOGIES = 0;
+	if ( cline -> GLUCOSE ) RESTARTER.init ( RESTARTGLUCOSE, 0 );
+	else if ( cline -> LUBY > 0 ) RESTARTER.init ( RESTARTLUBY, cline -> LUBY );
+	else if ( cline -> RESTARTS > 0 ) RESTARTER.init ( RESTARTFIXED, cline -> RESTARTS );
 }
 
-// Parse input and build the formula aka theory
-void Formula::BuildFormula ( CommandLine* cline ) {
-	//local variables
-	ifstream infile;
-	char line_buffer[3000];
-	char word_buffer[3000];
-	int clause_num = 0;
-	int atom_num = 0;
-	int var, val;
-	char ch;
-	char ch1;
-	string str;
-	Variable * temp_var = NULL;
-	Literal * temp_atom = NULL;
-	Clause * temp_clause = NULL;
+//Destructor
+Formula::~Formula () {
+	//the atoms of the clauses go with the arenas
+	for ( unsigned int i = 0; i < CLAUSELIST.size(); i++ )
+		delete CLAUSELIST[i];
+	for ( unsigned int i = 0; i < VARLIST.size(); i++ )
+		delete VARLIST[i];
+	for ( unsigned int i = 0; i < CONSTRAINTS.size(); i++ )
+		delete CONSTRAINTS[i];
+	for ( unsigned int i = 0; i < AMOS.size(); i++ )
+		delete AMOS[i];
+}
 
-	//to start variable from 1 and not from 0 we need this
-	VARLIST.push_back( new Variable(0, 0));
-	VARLIST[0]->SAT = true;
+//Reports a malformed input file, returns false for the reader to return
+static bool parseError ( const char * msg, int line ) {
+	cout<<endl;
+	cout<<"**** ERROR ****"<<endl;
+	cout<<msg<<" on line "<<line<<endl;
+	cout<<endl;
+	return false;
+}
+
+//Skips spaces, tabs and carriage returns, stops at the end of the line
+static const char * skipBlanks ( const char * p, const char * end ) {
+	while ( p < end && ( *p == ' ' || *p == '\t' || *p == '\r' ) ) p++;
+	return p;
+}
+
+//Skips the rest of the line and its newline
+static const char * nextLine ( const char * p, const char * end ) {
+	const char * nl = (const char *) memchr ( p, '\n', end - p );
+	return nl ? nl + 1 : end;
+}
+
+//Reads an unsigned decimal integer into value, returns NULL if there is none
+static const char * scanInt ( const char * p, const char * end, int & value ) {
+	if ( p == end || *p < '0' || *p > '9' ) return NULL;
+	long v = 0;
+	while ( p < end && *p >= '0' && *p <= '9' ) {
+		v = v * 10 + ( *p++ - '0' );
+		if ( v > INT_MAX ) return NULL;
+	}
+	value = v;
+	return p;
+}
+
+//Reads an atom var=val or var!=val, or the 0 that ends a clause which
+//leaves var 0, returns NULL if it is malformed
+static const char * scanAtom ( const char * p, const char * end, int & var, bool & eq, int & val ) {
+	p = scanInt ( p, end, var );
+	if ( !p || var == 0 ) return p;
+	if ( p < end && *p == '=' ) {
+		eq = true;
+		p++;
+	}
+	else if ( end - p > 1 && p[0] == '!' && p[1] == '=' ) {
+		eq = false;
+		p += 2;
+	}
+	else return NULL;
+	return scanInt ( p, end, val );
+}
+
+//Returns the line number of a position in the text
+static int lineOf ( const char * text, const char * pos ) {
+	return count ( text, pos, '\n' ) + 1;
+}
 
+// Parse input and build the formula aka theory
+// The file is mapped into memory and the tokens are read where they
+// are, so lines can be of any length
+bool Formula::BuildFormula ( CommandLine* cline ) {
 	TIME_S = GetTime();
 	//opening infile to read and checking if it opens
-	infile.open(cline->FILE, ios::in);
-	if(!infile)
+	int fd = open ( cline->FILE, O_RDONLY );
+	struct stat st;
+	if ( fd < 0 || fstat ( fd, &st ) < 0 )
 	{
 		cout<<endl;
 		cout<<"**** ERROR ****"<<endl;
 		cout<<"Could not open input file : "<<endl;
 		cout<<endl;
-		exit(1);
+		if ( fd >= 0 ) close ( fd );
+		return false;
+	}
+	size_t length = st.st_size;
+	const char * text = NULL;
+	if ( length > 0 ) {
+		void * map = mmap ( NULL, length, PROT_READ, MAP_PRIVATE, fd, 0 );
+		if ( map == MAP_FAILED )
+		{
+			cout<<endl;
+			cout<<"**** ERROR ****"<<endl;
+			cout<<"Could not map input file : "<<endl;
+			cout<<endl;
+			close ( fd );
+			return false;
+		}
+		madvise ( map, length, MADV_SEQUENTIAL );
+		text = (const char *) map;
+	}
+	close ( fd );
+
+	bool built = parseFormula ( text, length );
+
+	//unmapping file
+	if ( text ) munmap ( (void *) text, length );
+	return built;
+}
+
+// Build the theory from the text of an input, as read from a file or
+// received by the batch mode
+bool Formula::parseFormula ( const char * text, size_t length ) {
+	int var, val;
+	Variable * temp_var = NULL;
+
+	//to start variable from 1 and not from 0 we need this
+	VARLIST.push_back( new Variable(0, 0));
+	VARLIST[0]->SAT = true;
+
+	//a file written by -f2bin is loaded without parsing
+	if ( length >= sizeof ( BINARYHEADER ) && !memcmp ( text, BINARYMAGIC, 4 ) ) {
+		if ( !loadBinary ( text, length ) ) return false;
+		if ( SUBSUME ) simplifyClauses();
+		finishFormula();
+		return true;
 	}
 
-	//now reading each line from the infile and if needed to convert
-	//then converting it and writing to outfile or just writing directly
-	while(infile.getline(line_buffer, 3000))
+	const char * p = text;
+	const char * end = text + length;
+	//the header: comments, the problem line and the domains, up to the first clause
+	while ( p < end )
 	{
-		temp_clause = new Clause(cline->CLAUSE_SIZE);
-		//if line is comment - just write
-		if(line_buffer[0] == 'c')
+		const char * line = p;
+		p = skipBlanks ( p, end );
+		//blank lines are skipped, they are not empty clauses
+		if ( p == end || *p == '\n' )
 		{
-			//do nothing
-			;
+			p = nextLine ( p, end );
 		}
-		//else if line is p cnf var_num clause_num - just write
-		else if(line_buffer[0] == 'p')
+		//if line is comment - skip
+		else if ( *p == 'c' )
 		{
-			sscanf(line_buffer, "p cnf %d %d", &var, &val);
-
+			p = nextLine ( p, end );
+		}
+		//else if line is p cnf var_num clause_num - make room for them
+		else if ( *p == 'p' )
+		{
+			//skip the p and the format name
+			p = skipBlanks ( p + 1, end );
+			while ( p < end && *p != ' ' && *p != '\t' && *p != '\n' ) p++;
+			p = scanInt ( skipBlanks ( p, end ), end, var );
+			if ( p ) p = scanInt ( skipBlanks ( p, end ), end, val );
+			if ( !p ) return parseError ( "Malformed problem line", lineOf ( text, line ) );
+			//a clause takes at least two bytes, so a wrong count cannot
+			//reserve more than the file could hold
+			VARLIST.reserve ( min ( (size_t) var, length ) + 1 );
+			CLAUSELIST.reserve ( min ( (size_t) val, length / 2 ) );
+			p = nextLine ( p, end );
 		}
 		//else if line is d var# domsize
-		else if(line_buffer[0] == 'd')
+		else if ( *p == 'd' )
 		{
-			sscanf(line_buffer, "d %d %d", &var, &val);
+			p = scanInt ( skipBlanks ( p + 1, end ), end, var );
+			if ( p ) p = scanInt ( skipBlanks ( p, end ), end, val );
+			if ( !p ) return parseError ( "Malformed domain line", lineOf ( text, line ) );
+			//the literals of the clauses are packed into one integer
+			if(var > LITMAXVAR || val > LITMAXDOMAIN)
+			{
+				cout<<endl;
+				cout<<"**** ERROR ****"<<endl;
+				cout<<"Variable or domain too large : "<<var<<" "<<val<<endl;
+				cout<<endl;
+				return false;
+			}
 			temp_var = new Variable(var, val);
 			VARLIST.push_back(temp_var);
+			p = nextLine ( p, end );
 		}
-		//else its clause lines
+		//else the clauses start here
 		else
 		{
-			char * lp = line_buffer;
-			do
-			{
-				char * wp = word_buffer;
-				//erasing all leading space/tabs
-				while (*lp && ((*lp == ' ') || (*lp == '\t')))
-				{
-					lp++;
+			p = line;
+			break;
+		}
+	}
+
+	//the clause lines, the first error in the file is reported
+	CLAUSELINES lines;
+	lines.BEGIN = p;
+	lines.END = end;
+	parseClauseLines ( lines );
+	if ( lines.ERROR ) return parseError ( lines.ERROR, lineOf ( text, lines.ERRORPOS ) );
+
+	//the clauses go into the arena and the clause list in file order
+	LIT * atoms = INPUTARENA.alloc ( lines.LITS.size() );
+	if ( !lines.LITS.empty() )
+		memcpy ( atoms, &lines.LITS[0], lines.LITS.size() * sizeof ( LIT ) );
+	vector <LIT> ().swap ( lines.LITS );
+	CLAUSELIST.reserve ( CLAUSELIST.size() + lines.SIZES.size() );
+	for ( unsigned int c = 0; c < lines.SIZES.size(); c++ ) {
+		addInputClause ( atoms, lines.SIZES[c] );
+		atoms += lines.SIZES[c];
+	}
+
+	//the constraints, in file order too
+	vector<int>::const_iterator vars = lines.ALLDIFFVARS.begin();
+	for ( unsigned int k = 0; k < lines.ALLDIFFSIZES.size(); vars += lines.ALLDIFFSIZES[k++] )
+		addAllDifferent ( vector <int> ( vars, vars + lines.ALLDIFFSIZES[k] ) );
+	vector<LIT>::const_iterator amo = lines.AMOLITS.begin();
+	for ( unsigned int k = 0; k < lines.AMOSIZES.size(); amo += lines.AMOSIZES[k++] )
+		addAtMostOne ( vector <LIT> ( amo, amo + lines.AMOSIZES[k] ) );
+	vars = lines.TABLEVARS.begin();
+	vector<int>::const_iterator tuples = lines.TABLETUPLES.begin();
+	for ( unsigned int k = 0; k < lines.TABLEARITIES.size(); k++ ) {
+		addTable ( vector <int> ( vars, vars + lines.TABLEARITIES[k] ),
+		           vector <int> ( tuples, tuples + lines.TABLESIZES[k] ) );
+		vars += lines.TABLEARITIES[k];
+		tuples += lines.TABLESIZES[k];
+	}
+
+	if ( SUBSUME ) simplifyClauses();
+	finishFormula();
+	return true;
+}
+
+// Parse the clause lines of the input, atoms are var=val or var!=val
+// and 0 ends the clause. The first error stops the parsing, it is
+// reported by the caller
+void Formula::parseClauseLines ( CLAUSELINES & lines ) {
+
+	const char * p = lines.BEGIN;
+	const char * end = lines.END;
+	int var, val;
+	bool eq;
+	lines.ERROR = NULL;
+
+	while ( p < end ) {
+		const char * line = p;
+		p = skipBlanks ( p, end );
+		//blank lines, comments and a late problem line are skipped
+		if ( p == end || *p == '\n' || *p == 'c' || *p == 'p' ) {
+			p = nextLine ( p, end );
+			continue;
+		}
+		//the domains must be known before the clauses are read
+		if ( *p == 'd' ) {
+			lines.ERROR = "Domain line after the clauses";
+			lines.ERRORPOS = line;
+			return;
+		}
+		//a constraint, its name then its variables or atoms, ended by 0 like a clause
+		if ( isalpha ( *p ) ) {
+			lines.ERRORPOS = line;
+			const char * name = p;
+			while ( p < end && isalpha ( *p ) ) p++;
+			string keyword ( name, p );
+			if ( keyword == "alldifferent" ) {
+				size_t first = lines.ALLDIFFVARS.size();
+				while ( ( p = skipBlanks ( p, end ) ) < end && *p != '\n' ) {
+					p = scanInt ( p, end, var );
+					if ( !p ) { lines.ERROR = "Malformed constraint"; return; }
+					if ( var == 0 ) continue;
+					if ( var >= (int) VARLIST.size() ) {
+						lines.ERROR = "Variable of a constraint not declared";
+						return;
+					}
+					lines.ALLDIFFVARS.push_back ( var );
 				}
-				//reading each value into word buffer
-				while (*lp && (*lp != ' ') && (*lp != '\t') && (*lp != '\n'))
-				{
-					*(wp++) = *(lp++);
+				//a variable twice would make the constraint false
+				vector <int> vars ( lines.ALLDIFFVARS.begin() + first, lines.ALLDIFFVARS.end() );
+				sort ( vars.begin(), vars.end() );
+				if ( adjacent_find ( vars.begin(), vars.end() ) != vars.end() ) {
+					lines.ERROR = "Variable repeated in a constraint";
+					return;
 				}
-				*wp = '\0';
-				//converting into int and writing to file
-				if(strlen(word_buffer) != 0)
-				{
-					sscanf(word_buffer, "%d %c %d", &var, &ch, &val);
-					if(ch == '!')
-						sscanf(word_buffer, "%d %c %c %d", &var, &ch, &ch1, &val);
-					//checking if variable = 0 i.e end of line
-					if(var != 0)
-					{
-						//add it to clause_list's atom_list
-						temp_atom = new Literal(var, ch, val);
-						temp_clause->addAtom(temp_atom);
-
-						//increment the index representing value so that
-						//we can keep track of number of occurrences of each
-						//variable and its domain value, if ch is = then increment
-						//the value count, else increment others count
-						if(ch == '=')
-						{
-							VARLIST[var]->ATOMCNTPOS[val]++;
-							VARLIST[var]->addRecord(clause_num, val, true);
+				lines.ALLDIFFSIZES.push_back ( vars.size() );
+			}
+			else if ( keyword == "atmostone" || keyword == "exactlyone" ) {
+				size_t first = lines.AMOLITS.size();
+				while ( ( p = skipBlanks ( p, end ) ) < end && *p != '\n' ) {
+					p = scanAtom ( p, end, var, eq, val );
+					if ( !p ) { lines.ERROR = "Malformed atom"; return; }
+					if ( var == 0 ) continue;
+					if ( var >= (int) VARLIST.size() || val >= VARLIST[var] -> DOMAINSIZE ) {
+						lines.ERROR = "Atom outside of the declared domains";
+						return;
+					}
+					lines.AMOLITS.push_back ( makeLit ( var, eq, val ) );
+				}
+				//an atom twice would be counted twice
+				vector <LIT> atoms ( lines.AMOLITS.begin() + first, lines.AMOLITS.end() );
+				sort ( atoms.begin(), atoms.end() );
+				if ( adjacent_find ( atoms.begin(), atoms.end() ) != atoms.end() ) {
+					lines.ERROR = "Atom repeated in a constraint";
+					return;
+				}
+				lines.AMOSIZES.push_back ( atoms.size() );
+				//exactly one is also the clause of its atoms
+				if ( keyword == "exactlyone" ) {
+					lines.LITS.insert ( lines.LITS.end(), lines.AMOLITS.begin() + first, lines.AMOLITS.end() );
+					lines.SIZES.push_back ( atoms.size() );
+				}
+			}
+			else if ( keyword == "allowed" || keyword == "forbidden" ) {
+				//the variables, ended by 0, then the tuples up to the end of the line
+				vector <int> vars;
+				while ( ( p = skipBlanks ( p, end ) ) < end && *p != '\n' ) {
+					p = scanInt ( p, end, var );
+					if ( !p ) { lines.ERROR = "Malformed constraint"; return; }
+					if ( var == 0 ) break;
+					if ( var >= (int) VARLIST.size() ) {
+						lines.ERROR = "Variable of a constraint not declared";
+						return;
+					}
+					vars.push_back ( var );
+				}
+				vector <int> sorted ( vars );
+				sort ( sorted.begin(), sorted.end() );
+				if ( adjacent_find ( sorted.begin(), sorted.end() ) != sorted.end() ) {
+					lines.ERROR = "Variable repeated in a constraint";
+					return;
+				}
+				vector <int> tuples;
+				while ( ( p = skipBlanks ( p, end ) ) < end && *p != '\n' ) {
+					p = scanInt ( p, end, val );
+					if ( !p || vars.empty() ) { lines.ERROR = "Malformed constraint"; return; }
+					if ( val < 0 || val >= VARLIST[vars[tuples.size() % vars.size()]] -> DOMAINSIZE ) {
+						lines.ERROR = "Tuple outside of the declared domains";
+						return;
+					}
+					tuples.push_back ( val );
+				}
+				if ( vars.empty() || tuples.size() % vars.size() ) { lines.ERROR = "Malformed constraint"; return; }
+				int arity = vars.size();
+				//the tuples of the domains, to turn forbidden tuples into allowed ones
+				long long product = 1;
+				for ( int i = 0; i < arity && product <= TABLELIMIT; i++ )
+					product *= VARLIST[vars[i]] -> DOMAINSIZE;
+				if ( keyword == "forbidden" && product > TABLELIMIT ) {
+					for ( size_t t = 0; t < tuples.size(); t += arity ) {
+						for ( int i = 0; i < arity; i++ )
+							lines.LITS.push_back ( makeLit ( vars[i], false, tuples[t + i] ) );
+						lines.SIZES.push_back ( arity );
+					}
+				}
+				else {
+					if ( keyword == "forbidden" ) {
+						vector <bool> banned ( product, false );
+						for ( size_t t = 0; t < tuples.size(); t += arity ) {
+							long long index = 0;
+							for ( int i = 0; i < arity; i++ )
+								index = index * VARLIST[vars[i]] -> DOMAINSIZE + tuples[t + i];
+							banned[index] = true;
 						}
-						else
-						{
-							VARLIST[var]->ATOMCNTNEG[val]++;
-							VARLIST[var]->addRecord(clause_num, val, false);
+						tuples.clear();
+						vector <int> tuple ( arity, 0 );
+						for ( long long index = 0; index < product; index++ ) {
+							if ( ! banned[index] ) tuples.insert ( tuples.end(), tuple.begin(), tuple.end() );
+							for ( int i = arity - 1; i >= 0 && ++tuple[i] == VARLIST[vars[i]] -> DOMAINSIZE; i-- )
+								tuple[i] = 0;
 						}
-						VARLIST[var]->VSIDSCOUNTER[val]++;
-						atom_num++;
 					}
+					lines.TABLEVARS.insert ( lines.TABLEVARS.end(), vars.begin(), vars.end() );
+					lines.TABLEARITIES.push_back ( arity );
+					lines.TABLETUPLES.insert ( lines.TABLETUPLES.end(), tuples.begin(), tuples.end() );
+					lines.TABLESIZES.push_back ( tuples.size() );
 				}
-			}while(*lp);
-			CLAUSELIST.push_back(temp_clause);
+			}
+			else {
+				lines.ERROR = "Unknown constraint";
+				return;
+			}
+			p = nextLine ( p, end );
+			continue;
+		}
+		int size = 0;
+		while ( ( p = skipBlanks ( p, end ) ) < end && *p != '\n' ) {
+			lines.ERRORPOS = line;
+			p = scanAtom ( p, end, var, eq, val );
+			if ( !p ) { lines.ERROR = "Malformed atom"; return; }
+			//checking if variable = 0 i.e end of clause
+			if ( var == 0 ) continue;
+			if ( var >= (int) VARLIST.size() || val >= VARLIST[var] -> DOMAINSIZE ) {
+				lines.ERROR = "Atom outside of the declared domains";
+				return;
+			}
+			lines.LITS.push_back ( makeLit ( var, eq, val ) );
+			size++;
+		}
+		lines.SIZES.push_back ( size );
+		p = nextLine ( p, end );
+	}
+}
 
+// Add a clause of the input whose atoms are already in the arena
+void Formula::addInputClause ( LIT * atoms, int size ) {
 
-			if ( cline -> CMV ) {
+	CLAUSELIST.push_back ( new Clause ( atoms, size ) );
+}
 
-				// watch literals that concern different variable
+// Set up the watched literals of a clause of the input
+void Formula::initWatches ( int c_num ) {
 
-				Literal* watched1 = temp_clause -> ATOM_LIST[0];
+	Clause * temp_clause = CLAUSELIST[c_num];
+	int size = temp_clause -> NumAtom;
 
-				// we will be choosing a watched literal as a decision literal, thus track watched literals:
+	if ( CMV && size > 0 ) {
 
-				VARLIST[watched1 -> VAR] -> ATOMWATCH[watched1 -> VAL] = 1;
+		// watch literals that concern different variable
 
+		LIT watched1 = temp_clause -> ATOM_LIST[0];
 
-				Literal* watched2 = NULL;
+		// we will be choosing a watched literal as a decision literal, thus track watched literals:
 
-				if ( temp_clause -> NumAtom > 1 ) {
+		VARLIST[litVar ( watched1 )] -> ATOMWATCH[litVal ( watched1 )] = 1;
 
-					// by default assign the second literal:
-					temp_clause -> W2 = 1;
-					watched2 = temp_clause -> ATOM_LIST[1];
 
-					VARLIST[watched2 -> VAR] -> ATOMWATCH[watched2 -> VAL] = 2;
+		LIT watched2 = NOLIT;
 
-					for ( int i = 1; i < temp_clause -> NumAtom; i++) {
+		if ( temp_clause -> NumAtom > 1 ) {
 
-						// look for a literal with a different variable
+			// by default assign the second literal:
+			temp_clause -> W2 = 1;
+			watched2 = temp_clause -> ATOM_LIST[1];
 
-						if ( temp_clause -> ATOM_LIST[i] -> VAR != watched1 -> VAR ) {
+			VARLIST[litVar ( watched2 )] -> ATOMWATCH[litVal ( watched2 )] = 2;
 
-							temp_clause -> W2 = i;
+			for ( int i = 1; i < temp_clause -> NumAtom; i++) {
 
-							watched2 = temp_clause -> ATOM_LIST[i];
+				// look for a literal with a different variable
 
-							VARLIST[watched2 -> VAR] -> ATOMWATCH[watched2 -> VAL] = 2;
-							break;
+				if ( litVar ( temp_clause -> ATOM_LIST[i] ) != litVar ( watched1 ) ) {
 
-						}
-					}
+					temp_clause -> W2 = i;
 
-				}
+					watched2 = temp_clause -> ATOM_LIST[i];
 
-				// if only one literal, watched2 is null
+					VARLIST[litVar ( watched2 )] -> ATOMWATCH[litVal ( watched2 )] = 2;
+					break;
 
-				else {
-					temp_clause -> W2 = -1;
 				}
-
 			}
 
-			// with watched literals option, assign first two literals in the clause to watched1 and watched2
+		}
+
+		// if only one literal, watched2 is null
+
+		else {
+			temp_clause -> W2 = -1;
+		}
+
+	}
 
+	// with watched literals option, assign first two literals in the clause to watched1 and watched2
 
-			if ( cline -> WATCH ) {
 
-				Literal* watched1 = temp_clause -> ATOM_LIST[0];
-				temp_clause -> WATCHED[0] = watched1;
-				// we will be choosing a watched literal as a decision literal, thus track watched literals:
-				VARLIST[watched1 -> VAR] -> ATOMWATCH[watched1 -> VAL] = 1;
+	if ( WATCH && size > 0 ) {
 
-				if ( temp_clause -> NumAtom > 1 ) {
+		LIT watched1 = temp_clause -> ATOM_LIST[0];
+		temp_clause -> WATCHED[0] = watched1;
+		// we will be choosing a watched literal as a decision literal, thus track watched literals:
+		VARLIST[litVar ( watched1 )] -> ATOMWATCH[litVal ( watched1 )] = 1;
 
-					Literal* watched2 = temp_clause -> ATOM_LIST[1];
-					temp_clause -> WATCHED[1] = watched2;
-					VARLIST[watched2 -> VAR] -> ATOMWATCH[watched2 -> VAL] = 2;
+		if ( temp_clause -> NumAtom > 1 ) {
 
-				} else temp_clause -> WATCHED[1] = NULL; // if only one literal, watched2 is null
-			}
+			LIT watched2 = temp_clause -> ATOM_LIST[1];
+			temp_clause -> WATCHED[1] = watched2;
+			VARLIST[litVar ( watched2 )] -> ATOMWATCH[litVal ( watched2 )] = 2;
 
+		} else temp_clause -> WATCHED[1] = NOLIT; // if only one literal, watched2 is null
 
-			atom_num = 0;
-			++clause_num;
+		watchClause ( c_num );
+	}
+}
+
+// Remove the clauses of the input that repeat or are subsumed by another
+// one, and take away the values another one makes redundant
+void Formula::simplifyClauses () {
+
+	Subsumption subsumption ( VARLIST );
+	vector<int> ids ( CLAUSELIST.size() );
+	for ( unsigned int c = 0; c < CLAUSELIST.size(); c++ )
+		ids[c] = subsumption.add ( CLAUSELIST[c] -> ATOM_LIST, CLAUSELIST[c] -> NumAtom, true );
+	subsumption.simplify ( true );
+
+	int kept = 0;
+	for ( unsigned int c = 0; c < CLAUSELIST.size(); c++ ) {
+		Clause * clause = CLAUSELIST[c];
+		int id = ids[c];
+		if ( id < 0 || subsumption.REMOVED[id] ) {
+			INPUTARENA.release ( clause -> NumAtom );
+			delete clause;
+			continue;
+		}
+		if ( subsumption.CHANGED[id] ) {
+
+			// the clause is written again, where it was unless it grew
+
+			const vector<LIT> & atoms = subsumption.CLAUSES[id];
+			int size = atoms.size();
+			if ( size > clause -> NumAtom ) {
+				INPUTARENA.release ( clause -> NumAtom );
+				clause -> ATOM_LIST = INPUTARENA.alloc ( size );
+			} else INPUTARENA.release ( clause -> NumAtom - size );
+			for ( int i = 0; i < size; i++ )
+				clause -> ATOM_LIST[i] = atoms[i];
+			clause -> NumAtom = size;
+			clause -> NumUnAss = size;
 		}
+		CLAUSELIST[kept++] = clause;
 	}
+	CLAUSELIST.resize ( kept );
+
+	DUPLICATES += subsumption.DUPLICATES;
+	SUBSUMED += subsumption.SUBSUMED;
+	STRENGTHENED += subsumption.STRENGTHENED;
+	TAUTOLOGIES += subsumption.TAUTOLOGIES;
+	if ( LOG ) cout << "Removed " << subsumption.DUPLICATES << " duplicate, " << subsumption.SUBSUMED << " subsumed and "
+			<< subsumption.TAUTOLOGIES << " tautological clauses, " << subsumption.STRENGTHENED << " values" << endl;
+}
 
-	//closing file
-	infile.close();
+// Build what the search needs once all the clauses are read
+void Formula::finishFormula () {
+
+	// the watches are set up once the clauses of the input are final
+	if ( WATCH || CMV )
+		for ( unsigned int c = 0; c < CLAUSELIST.size(); c++ )
+			initWatches ( c );
+	numberAtoms();
+	buildOccurrences();
+	UNSATCLAUSES = CLAUSELIST.size();
+	ORIGINALCLAUSES = CLAUSELIST.size();
+	// the watched literal engine decides from the heap even without -evsids
+	if ( EVSIDS || WATCH ) buildHeap();
 	TIME_E = GetTime();
 }
 
+// Build the theory over the clauses of the input of master, which
+// must not search while this runs. The atoms stay in the input arena
+// of master and are only read, so master must outlive this formula
+void Formula::shareClauses ( const Formula * master ) {
+
+	TIME_S = GetTime();
+	VARLIST.push_back ( new Variable ( 0, 0 ) );
+	VARLIST[0] -> SAT = true;
+	for ( unsigned int i = 1; i < master -> VARLIST.size(); i++ )
+		VARLIST.push_back ( new Variable ( i, master -> VARLIST[i] -> DOMAINSIZE ) );
+
+	CLAUSELIST.reserve ( master -> ORIGINALCLAUSES );
+	for ( int c = 0; c < master -> ORIGINALCLAUSES; c++ )
+		addInputClause ( master -> CLAUSELIST[c] -> ATOM_LIST, master -> CLAUSELIST[c] -> NumAtom );
+	for ( unsigned int c = 0; c < master -> CONSTRAINTS.size(); c++ )
+		addConstraint ( master -> CONSTRAINTS[c] -> clone ( VARLIST ) );
+	for ( unsigned int c = 0; c < master -> AMOS.size(); c++ )
+		addAtMostOne ( master -> AMOS[c] -> ATOMS );
+	finishFormula();
+}
+
+// Load a formula written by writeBinary from the mapped file: the
+// domains give the variables, and the literals of all the clauses
+// are copied into the arena at once
+bool Formula::loadBinary ( const char * text, size_t length ) {
+
+	BINARYHEADER header;
+	memcpy ( &header, text, sizeof ( header ) );
+	if ( header.VERSION != BINARYVERSION ) {
+		cout<<endl;
+		cout<<"**** ERROR ****"<<endl;
+		cout<<"Binary file of an unknown version or byte order : "<<header.VERSION<<endl;
+		cout<<endl;
+		return false;
+	}
+
+	size_t domainbytes = binaryAlign ( (size_t) header.NUMVAR * sizeof ( unsigned int ) );
+	size_t offsetbytes = ( (size_t) header.NUMCLAUSE + 1 ) * sizeof ( unsigned long long );
+	const char * domains = text + sizeof ( header );
+	const char * offsets = domains + domainbytes;
+	const char * lits = offsets + offsetbytes;
+	if ( header.NUMVAR > (unsigned int) LITMAXVAR
+	     || (size_t) header.NUMCLAUSE >= length
+	     || length - sizeof ( header ) < domainbytes + offsetbytes
+	     || ( length - sizeof ( header ) - domainbytes - offsetbytes ) / sizeof ( LIT ) < header.NUMLIT ) {
+		cout<<endl;
+		cout<<"**** ERROR ****"<<endl;
+		cout<<"Truncated binary file"<<endl;
+		cout<<endl;
+		return false;
+	}
+
+	VARLIST.reserve ( header.NUMVAR + 1 );
+	for ( unsigned int i = 0; i < header.NUMVAR; i++ ) {
+		unsigned int domain;
+		memcpy ( &domain, domains + i * sizeof ( domain ), sizeof ( domain ) );
+		if ( domain > LITMAXDOMAIN ) {
+			cout<<endl;
+			cout<<"**** ERROR ****"<<endl;
+			cout<<"Variable or domain too large : "<<i + 1<<" "<<domain<<endl;
+			cout<<endl;
+			return false;
+		}
+		VARLIST.push_back ( new Variable ( i + 1, domain ) );
+	}
+
+	//one copy of all the literals, checked against the domains
+	LIT * stored = INPUTARENA.alloc ( header.NUMLIT );
+	memcpy ( stored, lits, header.NUMLIT * sizeof ( LIT ) );
+	for ( unsigned long long i = 0; i < header.NUMLIT; i++ ) {
+		int var = litVar ( stored[i] );
+		if ( var < 1 || var > (int) header.NUMVAR || litVal ( stored[i] ) >= VARLIST[var] -> DOMAINSIZE ) {
+			cout<<endl;
+			cout<<"**** ERROR ****"<<endl;
+			cout<<"Atom outside of the declared domains in binary file"<<endl;
+			cout<<endl;
+			return false;
+		}
+	}
+
+	CLAUSELIST.reserve ( header.NUMCLAUSE );
+	unsigned long long begin, next;
+	memcpy ( &begin, offsets, sizeof ( begin ) );
+	for ( unsigned int c = 0; c < header.NUMCLAUSE; c++ ) {
+		memcpy ( &next, offsets + ( c + 1 ) * sizeof ( next ), sizeof ( next ) );
+		if ( next < begin || next > header.NUMLIT ) {
+			cout<<endl;
+			cout<<"**** ERROR ****"<<endl;
+			cout<<"Bad clause offsets in binary file"<<endl;
+			cout<<endl;
+			return false;
+		}
+		addInputClause ( stored + begin, next - begin );
+		begin = next;
+	}
+	return true;
+}
+
+// Write the formula in the binary format read by loadBinary
+void Formula::writeBinary ( const char * file ) {
+
+	BINARYHEADER header;
+	memcpy ( header.MAGIC, BINARYMAGIC, 4 );
+	header.VERSION = BINARYVERSION;
+	header.NUMVAR = VARLIST.size() - 1;
+	header.NUMCLAUSE = ORIGINALCLAUSES;
+	header.NUMLIT = 0;
+	for ( int c = 0; c < ORIGINALCLAUSES; c++ )
+		header.NUMLIT += CLAUSELIST[c] -> NumAtom;
+
+	FILE * out = fopen ( file, "wb" );
+	if ( !out ) {
+		cout<<endl;
+		cout<<"**** ERROR ****"<<endl;
+		cout<<"Could not open output file : "<<endl;
+		cout<<endl;
+		exit(1);
+	}
+
+	fwrite ( &header, sizeof ( header ), 1, out );
+	vector <unsigned int> domains ( binaryAlign ( header.NUMVAR * sizeof ( unsigned int ) ) / sizeof ( unsigned int ), 0 );
+	for ( unsigned int i = 0; i < header.NUMVAR; i++ )
+		domains[i] = VARLIST[i + 1] -> DOMAINSIZE;
+	if ( !domains.empty() ) fwrite ( &domains[0], sizeof ( unsigned int ), domains.size(), out );
+
+	unsigned long long offset = 0;
+	fwrite ( &offset, sizeof ( offset ), 1, out );
+	for ( int c = 0; c < ORIGINALCLAUSES; c++ ) {
+		offset += CLAUSELIST[c] -> NumAtom;
+		fwrite ( &offset, sizeof ( offset ), 1, out );
+	}
+	for ( int c = 0; c < ORIGINALCLAUSES; c++ )
+		fwrite ( CLAUSELIST[c] -> ATOM_LIST, sizeof ( LIT ), CLAUSELIST[c] -> NumAtom, out );
+
+	if ( fclose ( out ) != 0 ) {
+		cout<<endl;
+		cout<<"**** ERROR ****"<<endl;
+		cout<<"Could not write output file : "<<endl;
+		cout<<endl;
+		exit(1);
+	}
+}
+
+// Read a cube file: comment lines start with c, every other line is a
+// cube, an a followed by its atoms and a 0
+bool Formula::readCubes ( const char * file, vector < vector <LIT> > & cubes ) {
+
+	ifstream in ( file );
+	if ( !in ) {
+		cout<<endl;
+		cout<<"**** ERROR ****"<<endl;
+		cout<<"Could not open cube file : "<<endl;
+		cout<<endl;
+		return false;
+	}
+
+	string text;
+	int number = 0;
+	while ( getline ( in, text ) ) {
+		number++;
+		const char * p = skipBlanks ( text.data(), text.data() + text.size() );
+		const char * end = text.data() + text.size();
+		if ( p == end || *p == 'c' ) continue;
+		if ( *p != 'a' ) return parseError ( "Malformed cube", number );
+
+		vector <LIT> cube;
+		int var = -1, val;
+		bool eq;
+		p++;
+		while ( ( p = skipBlanks ( p, end ) ) < end ) {
+			p = scanAtom ( p, end, var, eq, val );
+			if ( !p ) return parseError ( "Malformed atom", number );
+			if ( var == 0 ) break;
+			if ( var >= (int) VARLIST.size() || val >= VARLIST[var] -> DOMAINSIZE )
+				return parseError ( "Atom outside of the declared domains", number );
+			cube.push_back ( makeLit ( var, eq, val ) );
+		}
+		if ( var != 0 ) return parseError ( "Cube without its ending 0", number );
+		cubes.push_back ( cube );
+	}
+	return true;
+}
+
+// Write cubes in the format read by readCubes
+void Formula::writeCubes ( const char * file, const vector < vector <LIT> > & cubes ) {
+
+	FILE * out = fopen ( file, "w" );
+	if ( !out ) {
+		cout<<endl;
+		cout<<"**** ERROR ****"<<endl;
+		cout<<"Could not open output file : "<<endl;
+		cout<<endl;
+		exit(1);
+	}
+
+	fprintf ( out, "c %d cubes\n", (int) cubes.size() );
+	for ( unsigned int i = 0; i < cubes.size(); i++ ) {
+		fprintf ( out, "a" );
+		for ( unsigned int j = 0; j < cubes[i].size(); j++ )
+			fprintf ( out, " %d%s%d", litVar ( cubes[i][j] ), litEqual ( cubes[i][j] ) ? "=" : "!=", litVal ( cubes[i][j] ) );
+		fprintf ( out, " 0\n" );
+	}
+
+	if ( fclose ( out ) != 0 ) {
+		cout<<endl;
+		cout<<"**** ERROR ****"<<endl;
+		cout<<"Could not write output file : "<<endl;
+		cout<<endl;
+		exit(1);
+	}
+}
+
+// Count the atoms of the clauses and build their occurrence lists in
+// one flat array. The counts give the size of the slice of each atom,
+// then each clause is put at the next free place of its atoms' slices
+void Formula::buildOccurrences () {
+
+	size_t numlits = 0;
+	vector <int> counts ( SEEN.size(), 0 );
+	for ( unsigned int c = 0; c < CLAUSELIST.size(); c++ ) {
+		numlits += CLAUSELIST[c] -> NumAtom;
+		for ( int i = 0; i < CLAUSELIST[c] -> NumAtom; i++ )
+			counts[atomId ( CLAUSELIST[c] -> ATOM_LIST[i] )]++;
+	}
+
+	//turn the counts into the start of each slice
+	OCCARRAY.assign ( numlits, 0 );
+	int offset = 0;
+	for ( unsigned int i = 1; i < VARLIST.size(); i++ ) {
+		for ( int j = 0; j < VARLIST[i] -> DOMAINSIZE; j++ ) {
+			for ( int eq = 1; eq >= 0; eq-- ) {
+				int id = atomId ( makeLit ( i, eq, j ) );
+				OCCLIST & occ = eq ? VARLIST[i] -> ATOMRECPOS[j] : VARLIST[i] -> ATOMRECNEG[j];
+				int & count = eq ? VARLIST[i] -> ATOMCNTPOS[j] : VARLIST[i] -> ATOMCNTNEG[j];
+				occ.BASE = OCCARRAY.empty() ? NULL : &OCCARRAY[0] + offset;
+				count += counts[id];
+				occ.NUMBASE = count;
+				VARLIST[i] -> VSIDSCOUNTER[j] += count;
+				int range = counts[id];
+				counts[id] = offset;
+				offset += range;
+			}
+		}
+	}
+
+	// fill the slices in clause order
+	for ( unsigned int c = 0; c < CLAUSELIST.size(); c++ )
+		for ( int i = 0; i < CLAUSELIST[c] -> NumAtom; i++ )
+			OCCARRAY[counts[atomId ( CLAUSELIST[c] -> ATOM_LIST[i] )]++] = c;
+}
+
 // Printing functions
 
 void Formula::PrintVar()
@@ -266,7 +959,7 @@ void Formula::PrintModel()
 {
 	for(unsigned int  i=0; i<DECSTACK.size();i++)
 	{
-		if(DECSTACK[i]->EQUAL) DECSTACK[i]->Print();
+		if(litEqual ( DECSTACK[i] )) printLit ( DECSTACK[i] );
 	}
 	if (LOG) cout<<endl;
 }
@@ -295,7 +988,20 @@ void Formula::PrintInfo()
 	//  printf("Number of Levels      : %d\n", LEVEL);
 	printf( "Variables   : %zu\n", VARLIST.size()-1 );
 	printf( "Clauses     : %zu\n", CLAUSELIST.size() );
+	printf("Learned     : %d\n", LEARNEDCLAUSES);
+	printf("Kept        : %d\n", (int) CLAUSELIST.size() - ORIGINALCLAUSES);
+	printf("Deleted     : %d\n", DELETEDCLAUSES);
 	printf("Restarts   : %d\n", RESTARTS);
+	if ( ! CONSTRAINTS.empty() || ! AMOS.empty() ) {
+		printf("Constraints : %zu\n", CONSTRAINTS.size() + AMOS.size());
+		printf("Explained   : %d\n", EXPLAINED);
+	}
+	if ( SUBSUME || SUBSUMELEARNED ) {
+		printf("Duplicates  : %d\n", DUPLICATES);
+		printf("Subsumed    : %d\n", SUBSUMED);
+		printf("Strengthened: %d\n", STRENGTHENED);
+		printf("Tautologies : %d\n", TAUTOLOGIES);
+	}
 
 	printf("\n");
 }
@@ -309,44 +1015,33 @@ bool Formula::verifyModel() {
 	//which it occurs to true
 	int val = 0;
 	int domainsize = 0;
-	VARRECORD * curr = NULL;
 	for(unsigned int  i=1; i<VARLIST.size(); i++) {
 		val = VARLIST[i]->VAL;
 		if(val != -1) {
 			domainsize = VARLIST[i]->DOMAINSIZE;
 			for(int j=0; j<domainsize; j++) {
-				if(j != val) {
-					curr = VARLIST[i]->ATOMRECNEG[j];
-					while(curr) {
-						CLAUSELIST[curr->c_num]->SAT = true;
-						curr = curr->next;
-					}
-				}
-				else {
-					curr = VARLIST[i]->ATOMRECPOS[j];
-					while(curr) {
-						CLAUSELIST[curr->c_num]->SAT = true;
-						curr = curr->next;
-					}
-				}
+				OCCLIST & occ = (j != val) ? VARLIST[i]->ATOMRECNEG[j] : VARLIST[i]->ATOMRECPOS[j];
+				for(int k=0; k<occ.size(); k++)
+					CLAUSELIST[occ[k]]->SAT = true;
 			}
 		}
 		else {
 			domainsize = VARLIST[i]->DOMAINSIZE;
 			for(int j=0; j<domainsize; j++){
 				if(VARLIST[i]->ATOMASSIGN[j] == -1) {
-					curr = VARLIST[i]->ATOMRECNEG[j];
-					while(curr) {
-						CLAUSELIST[curr->c_num]->SAT = true;
-						curr = curr->next;
-					}
+					OCCLIST & occ = VARLIST[i]->ATOMRECNEG[j];
+					for(int k=0; k<occ.size(); k++)
+						CLAUSELIST[occ[k]]->SAT = true;
 				}
 				else
 					VARLIST[i]->VAL = j;
 			}
 		}
 	}
-	return (checkSat());
+	for(unsigned int  i=0; i<CLAUSELIST.size(); i++)
+		if(!CLAUSELIST[i]->SAT)
+			return false;
+	return constraintsHold();
 }
 
 // Functions used in the extended DPLL algorithm:
@@ -354,17 +1049,11 @@ bool Formula::verifyModel() {
 bool Formula::checkSat () {
 
 	// if some clause in the formula is not satisfied return false
+	// satisfyClauses and unsatisfyClauses keep the count of such clauses
 
 	if ( LOG ) cout << "Checking satisfiability..." << endl;
 
-	int size = CLAUSELIST.size();
-
-	for ( int i = 0; i < size; i++ ) {
-		if ( ! CLAUSELIST[i] -> SAT ) {
-			return false;
-		}
-	}
-	return true;
+	return UNSATCLAUSES == 0;
 }
 
 int Formula::checkConflict () {
@@ -405,6 +1094,21 @@ void Formula::checkUnit () {
 	}
 }
 
+void Formula::checkUnit ( int c_num ) {
+
+	// same check for a single clause, e.g. a clause just learned
+
+	Clause * clause = CLAUSELIST[c_num];
+
+	if ( clause -> SAT ) return;
+
+	if ( clause -> NumUnAss == 1 ) UNITLIST.push_back ( c_num );
+	else if ( clause -> NumUnAss == 0 ) {
+		CONFLICTINGCLAUSE = c_num;
+		CONFLICT = true;
+	}
+}
+
 bool Formula::checkEntail ( int var ) {
 
 	// check if there is exactly one domain value is not assigned for var
@@ -439,13 +1143,13 @@ bool Formula::checkEntail ( int var ) {
 	// if found an entail literal then assign memory to variable and return true
 
 	if ( flag ) {
-		ENTAILLITERAL = new Literal ( var, domainvalue );
+		ENTAILLITERAL = makeLit ( var, true, domainvalue );
 		return true;
 	}
 	return false;
 }
 
-Literal* Formula::chooseLiteral () {
+LIT Formula::chooseLiteral () {
 
 	/*  Pick a literal which is not yet satisfied, and which satisfies more clauses and removes less literals,
 	 *  use literal counts for this. Other heuristics are possible.
@@ -471,10 +1175,10 @@ Literal* Formula::chooseLiteral () {
 			}
 		}
 	}
-	return ( tvar != -1 ? new Literal ( tvar, tval ) : NULL );
+	return ( tvar != -1 ? makeLit ( tvar, true, tval ) : NOLIT );
 }
 
-Literal* Formula::chooseLiteralVSIDS () {
+LIT Formula::chooseLiteralVSIDS () {
 
 	/*  Pick a literal which is not yet satisfied, and which has a maximal vsids counter
 	 */
@@ -501,7 +1205,63 @@ Literal* Formula::chooseLiteralVSIDS () {
 			}
 		}
 	}
-	return ( tvar != -1 ? new Literal ( tvar, tval ) : NULL );
+	return ( tvar != -1 ? makeLit ( tvar, true, tval ) : NOLIT );
+}
+
+void Formula::numberAtoms () {
+
+	// number the atoms var by var, each atom has two literals to mark in SEEN
+
+	ATOMBASE.assign ( VARLIST.size(), 0 );
+
+	int atoms = 0;
+	for ( unsigned int i = 0; i < VARLIST.size(); i++ ) {
+		ATOMBASE[i] = atoms;
+		atoms += VARLIST[i] -> DOMAINSIZE;
+	}
+
+	SEEN.assign ( 2 * atoms, 0 );
+	SEENSTAMP = 0;
+}
+
+void Formula::buildHeap () {
+
+	// the occurrence counts are the first activities
+
+	HEAPLIT.clear();
+
+	for ( unsigned int i = 0; i < VARLIST.size(); i++ )
+		for ( int j = 0; j < VARLIST[i] -> DOMAINSIZE; j++ )
+			HEAPLIT.push_back ( makeLit ( i, true, j ) );
+
+	ATOMHEAP.init ( HEAPLIT.size() );
+
+	// a seed breaks the ties between equal counts at random
+	unsigned int state = SEED;
+	for ( unsigned int i = 0; i < VARLIST.size(); i++ ) {
+		for ( int j = 0; j < VARLIST[i] -> DOMAINSIZE; j++ ) {
+			ATOMHEAP.ACTIVITY[ATOMBASE[i] + j] = VARLIST[i] -> VSIDSCOUNTER[j];
+			if ( SEED ) ATOMHEAP.ACTIVITY[ATOMBASE[i] + j] += rand_r ( &state ) / ( RAND_MAX + 1.0 );
+			ATOMHEAP.insert ( ATOMBASE[i] + j );
+		}
+	}
+}
+
+LIT Formula::chooseLiteralHeap () {
+
+	/*  Pick the unassigned atom with the highest activity. Assigned atoms are dropped
+	 *  from the heap when they reach the top, backtracking puts them back
+	 */
+
+	UNITCLAUSE = -1;
+
+	while ( ! ATOMHEAP.empty() ) {
+		LIT atom = HEAPLIT[ATOMHEAP.removeMax()];
+		int var = litVar ( atom );
+		if ( ! VARLIST[var] -> SAT && VARLIST[var] -> ATOMASSIGN[litVal ( atom )] == 0 )
+			return atom;
+	}
+	return NOLIT;
 }
 
 void Formula::reduceTheory ( int var, bool equals, int val ) {
@@ -516,6 +1276,7 @@ void Formula::reduceTheory ( int var, bool equals, int val ) {
 		removeLiteral ( var, !equals, val );
 
 		VARLIST[var] -> ATOMASSIGN[val] = 1;
+		pushTrail ( var, val );
 		VARLIST[var] -> ATOMLEVEL[val] = LEVEL;
 
 		VARLIST[var] -> VAL = val;
@@ -530,8 +1291,8 @@ void Formula::reduceTheory ( int var, bool equals, int val ) {
 		}
 
 		//Add literal to the Decision Stack
-		DECSTACK.push_back ( new Literal ( var, '=', val ) );
-		VARLIST[var] -> ATOMINDEX[val] = DECSTACK.size() - 1; // to use in maxLit
+		DECSTACK.push_back ( makeLit ( var, true, val ) );
+		VARLIST[var] -> ATOMINDEX[val] = DECSTACK.size() - 1; // to use in analyzeConflict
 
 		//foreach domain value x from dom(v) which is not assigned assign it
 		for ( int i = 0; i < val && ! CONFLICT; i++ ) {
@@ -542,6 +1303,7 @@ void Formula::reduceTheory ( int var, bool equals, int val ) {
 				removeLiteral ( var, equals, i );
 
 				VARLIST[var] -> ATOMASSIGN[i] = -1;
+				pushTrail ( var, i );
 				VARLIST[var]->ATOMLEVEL[i] = LEVEL;
 				VARLIST[var]->CLAUSEID[i] = UNITCLAUSE;
 				VARLIST[var]->ATOMINDEX[i] = DECSTACK.size() - 1;
@@ -556,6 +1318,7 @@ void Formula::reduceTheory ( int var, bool equals, int val ) {
 				removeLiteral ( var, equals, i );
 
 				VARLIST[var] -> ATOMASSIGN[i] = -1;
+				pushTrail ( var, i );
 				VARLIST[var] -> ATOMLEVEL[i] = LEVEL;
 				VARLIST[var] -> CLAUSEID[i] = UNITCLAUSE;
 				VARLIST[var] -> ATOMINDEX[i] = DECSTACK.size() - 1;
@@ -569,20 +1332,21 @@ void Formula::reduceTheory ( int var, bool equals, int val ) {
 		removeLiteral ( var, !equals, val );
 
 		VARLIST[var] -> ATOMASSIGN[val] = -1;
+		pushTrail ( var, val );
 		VARLIST[var] -> ATOMLEVEL[val] = LEVEL;
 		VARLIST[var] -> CLAUSEID[val] = UNITCLAUSE;
-		VARLIST[var] -> ATOMINDEX[val] = DECSTACK.size() - 1;
 
-		DECSTACK.push_back ( new Literal ( var, '!', val ) );
+		DECSTACK.push_back ( makeLit ( var, false, val ) );
+		VARLIST[var] -> ATOMINDEX[val] = DECSTACK.size() - 1; // to use in analyzeConflict
 
 		// Check entailment on this variable
 
 		if ( checkEntail ( var ) ) {
 
 			ENTAILS++;
-			if ( LOG ) cout << "Entailment... " << ENTAILLITERAL -> VAR << "=" << ENTAILLITERAL -> VAL << endl;
+			if ( LOG ) cout << "Entailment... " << litVar ( ENTAILLITERAL ) << "=" << litVal ( ENTAILLITERAL ) << endl;
 			UNITCLAUSE = -2;
-			reduceTheory ( ENTAILLITERAL -> VAR, true, ENTAILLITERAL -> VAL );
+			reduceTheory ( litVar ( ENTAILLITERAL ), true, litVal ( ENTAILLITERAL ) );
 		}
 	}
 }
@@ -594,41 +1358,39 @@ inline void Formula::satisfyClauses ( int var, bool equals, int val ) {
 	bool lit_equal = false;
 	int lit_val = -1;
 
-	VARRECORD * current = NULL;
-
 	// Get clauses where the literal appears:
-	if ( equals ) current = VARLIST[var] -> ATOMRECPOS[val];
-	else current = VARLIST[var] -> ATOMRECNEG[val];
+	OCCLIST & occurrences = equals ? VARLIST[var] -> ATOMRECPOS[val] : VARLIST[var] -> ATOMRECNEG[val];
+
+	for ( int k = 0; k < occurrences.size(); k++ ) {
 
-	while ( current ) {
+		Clause * clause = CLAUSELIST[occurrences[k]];
 
 		// For every clause that contains this literal, satisfy it
 
-		if ( ! CLAUSELIST[current->c_num] -> SAT ) {
+		if ( ! clause -> SAT ) {
 
-			CLAUSELIST[current->c_num]->SAT = true;
-			CLAUSELIST[current->c_num]->LEVEL = LEVEL;
+			clause -> SAT = true;
+			clause -> LEVEL = LEVEL;
+			UNSATCLAUSES--;
 
 			// and update the counts for other unassigned literals in the clause (corresponds to deleting the clause from the theory)
 
-			for ( int i = 0; i < CLAUSELIST[current -> c_num] -> NumAtom; i++ ) {
+			for ( int i = 0; i < clause -> NumAtom; i++ ) {
 
-				lit_var = CLAUSELIST[current -> c_num] -> ATOM_LIST[i] -> VAR;
-				lit_equal = CLAUSELIST[current -> c_num] -> ATOM_LIST[i] -> EQUAL;
-				lit_val = CLAUSELIST[current -> c_num] -> ATOM_LIST[i] -> VAL;
+				lit_var = litVar ( clause -> ATOM_LIST[i] );
+				lit_equal = litEqual ( clause -> ATOM_LIST[i] );
+				lit_val = litVal ( clause -> ATOM_LIST[i] );
 
 				if ( VARLIST[lit_var] -> ATOMASSIGN[lit_val] == 0 ) {
 
-					CLAUSELIST[current->c_num]->NumUnAss--;
+					clause -> NumUnAss--;
 
 					if ( lit_equal ) VARLIST[lit_var] -> ATOMCNTPOS[lit_val]--;
 					else VARLIST[lit_var] -> ATOMCNTNEG[lit_val]--;
 				}
 			}
 		}
-		current = current -> next;
 	}
-	current = NULL;
 }
 
 
@@ -636,68 +1398,67 @@ inline void Formula::satisfyClauses ( int var, bool equals, int val ) {
 //removeLiteral
 inline void Formula::removeLiteral ( int var, bool equals, int val ) {
 
-	VARRECORD * current = NULL;
-
 	// for every record of this literal reduce the number of unassigned literals in unsatisfied clauses
 	// update counts
 
-	if ( equals ) current = VARLIST[var] -> ATOMRECPOS[val];
-	else current = VARLIST[var] -> ATOMRECNEG[val];
+	OCCLIST & occurrences = equals ? VARLIST[var] -> ATOMRECPOS[val] : VARLIST[var] -> ATOMRECNEG[val];
+
+	for ( int k = 0; k < occurrences.size(); k++ ) {
 
-	while ( current ) {
+		int c_num = occurrences[k];
+		Clause * clause = CLAUSELIST[c_num];
 
-		if( ! CLAUSELIST[current->c_num] -> SAT ) {
+		if( ! clause -> SAT ) {
 
-			CLAUSELIST[current->c_num]->NumUnAss--;
+			clause -> NumUnAss--;
 
 			if ( equals ) VARLIST[var] -> ATOMCNTPOS[val]--;
 			else VARLIST[var] -> ATOMCNTNEG[val]--;
 
-			//checking for units and conflicts right away:
+			//checking for units and conflicts right away, units are queued in FIFO order:
 
-			if ( CLAUSELIST[current->c_num] -> NumUnAss == 1 ) {
-				UNITLIST.push_front(current -> c_num);
+			if ( clause -> NumUnAss == 1 ) {
+				UNITLIST.push_back ( c_num );
 			}
 
-			if ( CLAUSELIST[current->c_num] -> NumUnAss == 0 ) {
+			if ( clause -> NumUnAss == 0 ) {
 
 				CONFLICT = true;
-				CONFLICTINGCLAUSE = current->c_num;
+				CONFLICTINGCLAUSE = c_num;
 			}
 		}
-		current = current->next;
 	}
-	current = NULL;
 }
 
 
 //unsatisfyClauses, used in undoTheory(level)
+//the atoms assigned after the clause got satisfied are already unassigned,
+//so the unassigned literals are exactly the ones to count again
 inline void Formula::unsatisfyClauses ( int var, bool equals, int val, int level ) {
 
-	VARRECORD * current = NULL;
-
 	int lit_var = -1;
 	bool lit_equal = false;
 	int lit_val = -1;
 
-	if ( equals ) current = VARLIST[var] -> ATOMRECPOS[val];
-	else current = VARLIST[var] -> ATOMRECNEG[val];
+	OCCLIST & occurrences = equals ? VARLIST[var] -> ATOMRECPOS[val] : VARLIST[var] -> ATOMRECNEG[val];
+
+	for ( int k = 0; k < occurrences.size(); k++ ) {
 
-	while ( current ) {
+		Clause * clause = CLAUSELIST[occurrences[k]];
 
-		if ( CLAUSELIST[current -> c_num] -> LEVEL > level ) {
+		if ( clause -> SAT && clause -> LEVEL > level ) {
 
-			for ( int i = 0; i < CLAUSELIST[current -> c_num] -> NumAtom; i++ ) {
+			clause -> NumUnAss = 0;
 
-				lit_var = CLAUSELIST[current->c_num]->ATOM_LIST[i]->VAR;
-				lit_equal = CLAUSELIST[current->c_num]->ATOM_LIST[i]->EQUAL;
-				lit_val = CLAUSELIST[current->c_num]->ATOM_LIST[i]->VAL;
+			for ( int i = 0; i < clause -> NumAtom; i++ ) {
 
-				if ( ( VARLIST[lit_var] -> ATOMLEVEL[lit_val] > level )
-						|| ( VARLIST[lit_var] -> ATOMASSIGN[lit_val] == 0 ) ) {
+				lit_var = litVar ( clause -> ATOM_LIST[i] );
+				lit_equal = litEqual ( clause -> ATOM_LIST[i] );
+				lit_val = litVal ( clause -> ATOM_LIST[i] );
 
-					CLAUSELIST[current -> c_num] -> NumUnAss++;
+				if ( VARLIST[lit_var] -> ATOMASSIGN[lit_val] == 0 ) {
 
+					clause -> NumUnAss++;
 					if ( lit_equal )
 						VARLIST[lit_var]->ATOMCNTPOS[lit_val]++;
 					else
@@ -706,111 +1467,86 @@ inline void Formula::unsatisfyClauses ( int var, bool equals, int val, int level
 				}
 			}
 
-			CLAUSELIST[current->c_num]->LEVEL = -1;
-			CLAUSELIST[current->c_num]->SAT = false;
+			clause -> LEVEL = -1;
+			clause -> SAT = false;
+			UNSATCLAUSES++;
 		}
-		current = current->next;
 	}
-	current = NULL;
 }
 
 //addLiteral : used when undoing the theory
 inline void Formula::addLiteral ( int var, bool equals, int val ) {
 
-	VARRECORD * current = NULL;
-
 	//for every record of this literal increase the number of
 	//unassigned literals from unsatisfied clauses
 
-	if ( equals ) current = VARLIST[var] -> ATOMRECPOS[val];
-	else current = VARLIST[var] -> ATOMRECNEG[val];
+	OCCLIST & occurrences = equals ? VARLIST[var] -> ATOMRECPOS[val] : VARLIST[var] -> ATOMRECNEG[val];
+
+	for ( int k = 0; k < occurrences.size(); k++ ) {
+
+		Clause * clause = CLAUSELIST[occurrences[k]];
 
-	while ( current ) {
-		if ( ! CLAUSELIST[current -> c_num] -> SAT ) {
+		if ( ! clause -> SAT ) {
 
-			CLAUSELIST[current -> c_num] -> NumUnAss++;
+			clause -> NumUnAss++;
 
 			if ( equals ) VARLIST[var] -> ATOMCNTPOS[val]++;
 			else VARLIST[var] -> ATOMCNTNEG[val]++;
 		}
-		current = current->next;
 	}
-	current = NULL;
 }
 
 
-bool Formula::hasAtom ( Clause* clause, Literal* atom ) {
+inline int Formula::atomId ( LIT atom ) {
 
-	// true if clause contains the atom
+	// number of the literal among all literals, for the SEEN markers
 
-	for ( int i = 0; i < clause -> NumAtom; i++ ) {
-
-		Literal* c_atom = clause -> ATOM_LIST[i];
-
-		if ( LitIsEqual (atom, c_atom) )
-			return true;
-	}
-	return false;
+	return 2 * ( ATOMBASE[litVar ( atom )] + litVal ( atom ) ) + ( litEqual ( atom ) ? 1 : 0 );
 }
 
-Clause* Formula::resolve ( Clause* clause, Literal* literal, Clause* reason ) {
+void Formula::resolve ( LIT literal, const LIT * reason, int size ) {
 
-	//  Performs extended resolution on clause and reason wrt literal.
+	//  Performs extended resolution on RESOLVENT and reason wrt literal, in place.
 	// (See pp.47-50 of Jain: https://github.com/akinanop/mvl-solver/blob/master/literature/Jain_thesis.pdf)
 
-	Clause * resolvent = new Clause();
-
-	// Add literals L from the clause that are satisfied by at least one interpretation that does not satisfy L:
-
-	for ( unsigned int i = 0; i < clause -> ATOM_LIST.size(); i++ ) {
-
-		Literal* c_atom = clause -> ATOM_LIST[i];
-
-		if ( c_atom -> VAR != literal -> VAR ) resolvent -> addAtom ( c_atom );
-		else if ( c_atom -> VAL != literal -> VAL && c_atom -> EQUAL != literal -> EQUAL ) resolvent -> addAtom ( c_atom );
-		else if ( falsifies ( c_atom, literal ) ) resolvent -> addAtom ( c_atom );
+	// a new stamp unmarks all literals of the previous step
 
+	if ( ++SEENSTAMP == INT_MAX ) {
+		SEEN.assign ( SEEN.size(), 0 );
+		SEENSTAMP = 1;
 	}
-	// Add literals L from the reason clause that are satisfied by at least one interpretation that also satisfies L, i.e., doesn't falsify.
-
-	for ( unsigned int  i = 0; i < reason -> ATOM_LIST.size(); i++ ) {
-
-		Literal* r_atom = reason -> ATOM_LIST[i];
 
-		if ( ! falsifies ( r_atom, literal ) && ! hasAtom ( resolvent, r_atom ) ) resolvent -> addAtom ( r_atom );
+	// Keep literals L from the clause that are satisfied by at least one interpretation that does not satisfy L:
 
-	}
-
-	return resolvent;
-}
+	int kept = 0;
 
+	for ( unsigned int i = 0; i < RESOLVENT.size(); i++ ) {
 
+		LIT c_atom = RESOLVENT[i];
 
-bool Formula::potent ( Clause* clause ) {
-
-	// Check if there is exactly one atom falsified at the current level
+		if ( litVar ( c_atom ) != litVar ( literal )
+				|| ( litVal ( c_atom ) != litVal ( literal ) && litEqual ( c_atom ) != litEqual ( literal ) )
+				|| falsifies ( c_atom, literal ) ) {
+			RESOLVENT[kept++] = c_atom;
+			SEEN[atomId ( c_atom )] = SEENSTAMP;
+		}
+	}
+	RESOLVENT.resize ( kept );
 
-	LASTFALSE = -1;
-	int index = 0;
-	int counter = 0;
+	// Add literals L from the reason clause that are satisfied by at least one interpretation that also satisfies L, i.e., doesn't falsify.
 
-	for ( int i = 0; i < clause -> NumAtom; i++ ) {
+	for ( int i = 0; i < size; i++ ) {
 
-		Literal* atom = clause -> ATOM_LIST[i];
+		LIT r_atom = reason[i];
 
-		if ( VARLIST[atom -> VAR] -> ATOMLEVEL[atom -> VAL] == LEVEL ) {
-			counter++;
-			index = i;
+		if ( ! falsifies ( r_atom, literal ) && SEEN[atomId ( r_atom )] != SEENSTAMP ) {
+			RESOLVENT.push_back ( r_atom );
+			SEEN[atomId ( r_atom )] = SEENSTAMP;
 		}
 	}
+}
 
-	if ( counter != 1 ) return false;
 
-	else {
-		LASTFALSE = index;
-		return true;
-	}
-}
 
 int Formula::backtrackLevel ( Clause * learnedClause ) {
 
@@ -831,8 +1567,8 @@ int Formula::backtrackLevel ( Clause * learnedClause ) {
 
 	for ( int i = 0; i < csize; i++ ) {
 
-		Literal* atom = learnedClause -> ATOM_LIST[i];
-		int atom_level = VARLIST[atom -> VAR] -> ATOMLEVEL[atom -> VAL];
+		LIT atom = learnedClause -> ATOM_LIST[i];
+		int atom_level = VARLIST[litVar ( atom )] -> ATOMLEVEL[litVal ( atom )];
 
 		if ( LEVEL > atom_level && max < atom_level ) {
 			max = atom_level;
@@ -847,137 +1583,101 @@ int Formula::backtrackLevel ( Clause * learnedClause ) {
 	else return LEVEL-1;
 }
 
-void Formula::undoTheory ( int level ) {
+// pushTrail : records an atom assignment on the trail of the current level
+inline void Formula::pushTrail ( int var, int val ) {
 
-	// Undo theory to the level
-	// for each variable v, for each domain d from dom(v): if this value has been assigned at level this or greater undo
+	// open the markers of the levels that have no assignment yet
 
-	for ( unsigned int  i = 1; i < VARLIST.size(); i++ ) {
+	while ( (int) TRAILLIM.size() <= LEVEL ) TRAILLIM.push_back ( TRAIL.size() );
 
-		for ( int j = 0; j < VARLIST[i] -> DOMAINSIZE; j++ ) {
-
-			if ( VARLIST[i] -> ATOMLEVEL[j] > level ) {
-
-				if ( VARLIST[i] -> ATOMASSIGN[j] == -1 )
-					addLiteral ( i, true, j );
-				else
-					addLiteral ( i, false, j );
-			}
-		}
-	}
-
-	for ( unsigned int  i = 1; i < VARLIST.size(); i++ ) {
-
-		for ( int j = 0; j < VARLIST[i] -> DOMAINSIZE; j++ ) {
-
-			if ( VARLIST[i] -> ATOMLEVEL[j] > level ) {
-
-				if ( VARLIST[i] -> ATOMASSIGN[j] == -1)
-					unsatisfyClauses (i, false, j, level );
-				else
-					unsatisfyClauses ( i, true, j, level );
-
-				VARLIST[i]->ATOMLEVEL[j] = -10;
-				VARLIST[i]->ATOMASSIGN[j] = 0;
-				VARLIST[i]->CLAUSEID[j] = -10;
-			}
-		}
-
-		if(VARLIST[i] -> LEVEL > level) {
-
-			VARLIST[i] -> LEVEL = -1;
-			VARLIST[i] -> SAT = false;
-			VARLIST[i] -> VAL = -1;
-		}
-	}
-	//undo the decision stack
-
-	int decsize = DECSTACK.size();
-
-	for ( int i = decsize-1; i > -1; i-- ) {
-		if ( VARLIST[DECSTACK[i] -> VAR] -> ATOMASSIGN[DECSTACK[i] -> VAL] == 0 ) {
-			DECSTACK.erase ( DECSTACK.begin() + i );
-		}
-	}
+	TRAILRECORD record;
+	record.var = var;
+	record.val = val;
+	TRAIL.push_back ( record );
 }
 
+void Formula::undoTheory ( int level ) {
 
-// Corresponding functions for watched literals version of the algorithm:
+	// Undo theory to the level
+	// pop the atoms assigned above the level from the trail, latest first
 
-inline void Formula::watchedSatisfyLiteral ( int var, bool equals, int val ) {
+	if ( (int) TRAILLIM.size() <= level + 1 ) return;
 
-	VARRECORD * current = NULL;
+	int stop = TRAILLIM[level + 1];
+	undoConstraints ( stop );
 
-	// get clauses with the literal
+	for ( int t = TRAIL.size() - 1; t >= stop; t-- ) {
 
-	if ( equals ) current = VARLIST[var] -> ATOMRECPOS[val];
-	else current = VARLIST[var] -> ATOMRECNEG[val];
+		int var = TRAIL[t].var;
+		int val = TRAIL[t].val;
+		bool equals = ( VARLIST[var] -> ATOMASSIGN[val] == 1 );
 
-	/*
-	 * for every clause that contains this literal update watched literals, as described here:
-	   https://github.com/akinanop/mvl-solver/blob/master/literature/Watched%20literals.pdf
-	 */
+		VARLIST[var] -> ATOMASSIGN[val] = 0;
+		VARLIST[var] -> ATOMLEVEL[val] = -10;
+		VARLIST[var] -> CLAUSEID[val] = -10;
 
-	Literal* literal = new Literal(var, val);
-	literal->EQUAL=equals;
+		if ( EVSIDS ) ATOMHEAP.insert ( ATOMBASE[var] + val );
 
-	while ( current ) {
+		// the falsified and the satisfied literal of the atom are unassigned again in
+		// the unsatisfied clauses, then the clauses it satisfied are counted again
 
-		// assign the satisfied literal from the clause to be watched1
+		addLiteral ( var, ! equals, val );
+		addLiteral ( var, equals, val );
+		unsatisfyClauses ( var, equals, val, level );
 
-		Clause* clause = CLAUSELIST[current->c_num];
+		if ( VARLIST[var] -> LEVEL > level ) {
 
-		Literal* watched1 = CLAUSELIST[current->c_num]->WATCHED[0];
-		Literal* watched2 = CLAUSELIST[current->c_num]->WATCHED[1];
+			if ( VARLIST[var] -> VAL != -1 ) VARLIST[var] -> SAVED = VARLIST[var] -> VAL;
+			VARLIST[var] -> LEVEL = -1;
+			VARLIST[var] -> SAT = false;
+			VARLIST[var] -> VAL = -1;
+		}
+	}
 
-		if ( sat ( CLAUSELIST[current->c_num]->WATCHED[0] )  != 1 ) {
+	TRAIL.resize ( stop );
+	TRAILLIM.resize ( level + 1 );
 
-			if ( CLAUSELIST[current->c_num]->WATCHED[1] != NULL && ! LitIsEqual ( CLAUSELIST[current->c_num]->WATCHED[1], literal ) ) {
+	//undo the decision stack
 
-				CLAUSELIST[current->c_num]->WATCHED[0] = literal;
+	while ( ! DECSTACK.empty() && VARLIST[litVar ( DECSTACK.back() )] -> ATOMASSIGN[litVal ( DECSTACK.back() )] == 0 )
+		DECSTACK.pop_back ();
+}
 
-			} else {
 
-				CLAUSELIST[current->c_num]->WATCHED[1] = CLAUSELIST[current->c_num]->WATCHED[0];
-				CLAUSELIST[current->c_num]->WATCHED[0] = literal;
-			}
-		}
-		current = current -> next;
-	}
-}
+// Corresponding functions for watched literals version of the algorithm:
 
 
 inline void Formula::tempwatchedSatisfyLiteral ( int var, bool equals, int val ) {
 
-	VARRECORD * current = NULL;
 
 	// get clauses with the literal
 
-	if ( equals ) current = VARLIST[var] -> ATOMRECPOS[val];
-	else current = VARLIST[var] -> ATOMRECNEG[val];
+	OCCLIST & occurrences = equals ? VARLIST[var] -> ATOMRECPOS[val] : VARLIST[var] -> ATOMRECNEG[val];
 
 	/*
 	 * for every clause that contains this literal update watched literals, as described here:
 	   https://github.com/akinanop/mvl-solver/blob/master/literature/Watched%20literals.pdf
 	 */
 
-	while ( current ) {
+	for ( int k = 0; k < occurrences.size(); k++ ) {
+
+		int c_num = occurrences[k];
 
 		// assign the satisfied literal from the clause to be watched1
 		// use supports
 		// just assign sat to a clause??
 
-		Clause* clause = CLAUSELIST[current->c_num];
+		Clause* clause = CLAUSELIST[c_num];
 
-		Literal* watched1 = clause -> ATOM_LIST[ clause -> W1];
-		Literal* watched2 = NULL;
+		LIT watched1 = clause -> ATOM_LIST[ clause -> W1];
+		LIT watched2 = NOLIT;
 
 		if ( clause -> W2 == -1 ) clause -> W1 = 0;
 		else {
 
 			watched2 = clause -> ATOM_LIST[ clause -> W2];
 
-			Literal* literal = NULL;
+			LIT literal = NOLIT;
 
 			int index = 0;
 
@@ -988,12 +1688,12 @@ inline void Formula::tempwatchedSatisfyLiteral ( int var, bool equals, int val )
 
 				for ( int j = 0; j < clause -> NumAtom; j++ ) {
 
-					Literal* temp = clause -> ATOM_LIST[j];
+					LIT temp = clause -> ATOM_LIST[j];
 
-					if ( temp -> VAR == var &&  temp -> VAL == val &&
-							temp -> EQUAL == equals ) {
+					if ( litVar ( temp ) == var &&  litVal ( temp ) == val &&
+							litEqual ( temp ) == equals ) {
 
-						literal = CLAUSELIST[current->c_num] -> ATOM_LIST[j];
+						literal = CLAUSELIST[c_num] -> ATOM_LIST[j];
 						index = j;
 						break;
 					}
@@ -1008,7 +1708,6 @@ inline void Formula::tempwatchedSatisfyLiteral ( int var, bool equals, int val )
 			}
 
 		}
-		current = current -> next;
 	}
 }
 
@@ -1019,36 +1718,36 @@ inline void Formula::tempwatchedSatisfyLiteral ( int var, bool equals, int val )
  *
 inline void Formula::tempwatchedSatisfyLiteral ( int var, bool equals, int val ) {
 
-	VARRECORD * current = NULL;
 
 	// get clauses with the literal
 
-	if ( equals ) current = VARLIST[var] -> ATOMRECPOS[val];
-	else current = VARLIST[var] -> ATOMRECNEG[val];
+	OCCLIST & occurrences = equals ? VARLIST[var] -> ATOMRECPOS[val] : VARLIST[var] -> ATOMRECNEG[val];
+
+	for ( int k = 0; k < occurrences.size(); k++ ) {
 
-	while ( current ) {
+		int c_num = occurrences[k];
 
 		// assign the satisfied literal from the clause to be watched1
 		// use supports
 
-		Clause* clause = CLAUSELIST[current->c_num];
+		Clause* clause = CLAUSELIST[c_num];
 
-		Literal* watched1 = clause -> ATOM_LIST[ clause -> W1];
-		Literal* watched2 = NULL;
+		LIT watched1 = clause -> ATOM_LIST[ clause -> W1];
+		LIT watched2 = NOLIT;
 
 		if ( clause -> W2 > -1 ) watched2 = clause -> ATOM_LIST[ clause -> W2];
 
-		Literal* literal = NULL;
+		LIT literal = NOLIT;
 		int index = 0;
 
 		for ( int j = 0; j < clause -> NumAtom; j++ ) {
 
-			Literal* temp = clause -> ATOM_LIST[j];
+			LIT temp = clause -> ATOM_LIST[j];
 
-			if ( temp -> VAR == var &&  temp -> VAL == val &&
-					temp -> EQUAL == equals ) {
+			if ( litVar ( temp ) == var &&  litVal ( temp ) == val &&
+					litEqual ( temp ) == equals ) {
 
-				literal = CLAUSELIST[current->c_num] -> ATOM_LIST[j];
+				literal = CLAUSELIST[c_num] -> ATOM_LIST[j];
 				index = j;
 				break;
 			}
@@ -1056,7 +1755,7 @@ inline void Formula::tempwatchedSatisfyLiteral ( int var, bool equals, int val )
 
 		if ( sat ( watched1 )  != 1 ) {
 
-			if ( watched2 != NULL && ! LitIsEqual ( watched2, literal ) ) {
+			if ( watched2 != NOLIT && ! LitIsEqual ( watched2, literal ) ) {
 
 				clause -> W1 = index;
 
@@ -1066,7 +1765,6 @@ inline void Formula::tempwatchedSatisfyLiteral ( int var, bool equals, int val )
 				clause -> W1 = index;
 			}
 		}
-		current = current -> next;
 	}
 }
  *
@@ -1089,18 +1787,18 @@ bool Formula::supported ( int var, Clause * clause ) {
 	// var != val interpreted as positive disjunction with all values except val
 	// if clause contains neg and positive occurences, should be absorbed (FIXME in learning) or added
 
-	for ( int i = 0; i < clause -> ATOM_LIST.size(); i++ ) {
+	for ( int i = 0; i < clause -> NumAtom; i++ ) {
 
 
-		if ( clause -> ATOM_LIST[i] -> VAR == var && clause -> ATOM_LIST[i] -> EQUAL ) {
+		if ( litVar ( clause -> ATOM_LIST[i] ) == var && litEqual ( clause -> ATOM_LIST[i] ) ) {
 			pos_counter++;
 			var_counter++;
 		}
 
-		if ( pos_counter > 0 && clause -> ATOM_LIST[i] -> VAR == var && ! clause -> ATOM_LIST[i] -> EQUAL )
+		if ( pos_counter > 0 && litVar ( clause -> ATOM_LIST[i] ) == var && ! litEqual ( clause -> ATOM_LIST[i] ) )
 			var_counter = VARLIST[var] -> DOMAINSIZE;
 
-		else if ( clause -> ATOM_LIST[i] -> VAR == var && ! clause -> ATOM_LIST[i] -> EQUAL )
+		else if ( litVar ( clause -> ATOM_LIST[i] ) == var && ! litEqual ( clause -> ATOM_LIST[i] ) )
 			neg_counter++;
 
 		pos_counter = 0;
@@ -1117,92 +1815,119 @@ bool Formula::supported ( int var, Clause * clause ) {
 }
 
 
-inline void Formula::watchedSatisfyLiteral( Literal * literal ) {
+inline void Formula::tempwatchedSatisfyLiteral( LIT literal ) {
 
 	// we don't need to  update counts any more
 
-	watchedSatisfyLiteral ( literal -> VAR, literal -> EQUAL, literal -> VAL);
+	tempwatchedSatisfyLiteral ( litVar ( literal ), litEqual ( literal ), litVal ( literal ));
 }
 
-inline void Formula::tempwatchedSatisfyLiteral( Literal * literal ) {
 
-	// we don't need to  update counts any more
+// watchClause : register a clause in the watch lists of its two watched literals
+void Formula::watchClause ( int c_num ) {
 
-	tempwatchedSatisfyLiteral ( literal -> VAR, literal -> EQUAL, literal -> VAL);
-}
+	Clause* clause = CLAUSELIST[c_num];
 
+	for ( int w = 0; w < 2; w++ ) {
 
-// falsify clauses with the literal
-inline void Formula::watchedFalsifyLiteral ( Literal* literal ) {
+		LIT watched = clause -> WATCHED[w];
 
-	VARRECORD* current = NULL;
+		if ( watched == NOLIT ) continue;
 
-	int var = literal -> VAR;
-	int val = literal -> VAL;
-	bool equals = literal -> EQUAL;
+		if ( litEqual ( watched ) ) VARLIST[litVar ( watched )] -> WATCHPOS[litVal ( watched )].push_back ( c_num );
+		else VARLIST[litVar ( watched )] -> WATCHNEG[litVal ( watched )].push_back ( c_num );
+	}
+}
 
-	// Go through all occurrences of the literal in clauses and update watched literals
+// falsify the literal: visit only the clauses watching it
+inline void Formula::watchedFalsifyLiteral ( int var, bool equals, int val ) {
 
-	if ( equals ) current = VARLIST[var] -> ATOMRECPOS[val];
-	else current = VARLIST[var] -> ATOMRECNEG[val];
+	vector<int> & watches = equals ? VARLIST[var] -> WATCHPOS[val] : VARLIST[var] -> WATCHNEG[val];
+	LIT falsified = makeLit ( var, equals, val );
 
-	while ( current ) {
+	unsigned int i = 0;
+	unsigned int j = 0;
 
-		Literal* watched1 = CLAUSELIST[current -> c_num] -> WATCHED[0];
-		Literal* watched2 = CLAUSELIST[current -> c_num] -> WATCHED[1];
+	for ( ; i < watches.size(); i++ ) {
 
-		if ( sat ( watched1 ) != 1  &&
-				( LitIsEqual ( watched1, literal ) ||
-						( watched2 != NULL && LitIsEqual( watched2, literal ) ) ) ) SwapPointer ( CLAUSELIST[current -> c_num] );
+		int c_num = watches[i];
+		Clause* clause = CLAUSELIST[c_num];
 
-		current = current -> next;
-	}
+		// after a conflict just keep the remaining watches in place
 
-	current = NULL;
+		if ( CONFLICT ) {
+			watches[j++] = c_num;
+			continue;
+		}
 
-}
+		// make the falsified literal watched2; drop the entry if the clause does not watch it any more
 
-inline void Formula::watchedFalsifyLiteral ( int var, bool equals, int val ) {
+		LIT watched1 = clause -> WATCHED[0];
+		LIT watched2 = clause -> WATCHED[1];
 
+		if ( watched1 == falsified ) {
 
-//	cout << "Falsifying " << var << ( equals ? "=" : "!" ) << val << endl;
-	VARRECORD* current = NULL;
+			// a clause with one literal has nothing left
 
-	// Go through all occurrences of the literal in clauses and update watched literals
+			if ( watched2 == NOLIT ) {
+				watches[j++] = c_num;
+				CONFLICT = true;
+				CONFLICTINGCLAUSE = c_num;
+				continue;
+			}
+			clause -> WATCHED[0] = watched2;
+			clause -> WATCHED[1] = watched1;
+		}
+		else if ( watched2 != falsified )
+			continue;
 
-	if ( equals ) current = VARLIST[var] -> ATOMRECPOS[val];
-	else current = VARLIST[var] -> ATOMRECNEG[val];
+		watched1 = clause -> WATCHED[0];
+		watched2 = clause -> WATCHED[1];
 
-	while ( current &&!CONFLICT ) {
+		// clause is satisfied by the other watched literal, nothing to do
 
-		// CLAUSELIST[current -> c_num] -> Print();
+		if ( sat ( watched1 ) == 1 ) {
+			watches[j++] = c_num;
+			continue;
+		}
 
-		Literal* watched1 = CLAUSELIST[current -> c_num] -> WATCHED[0];
-		Literal* watched2 = CLAUSELIST[current -> c_num] -> WATCHED[1];
+		// look for a replacement which is not falsified
 
-		if ( sat ( watched1 ) != 1 &&  watched2 != NULL  )  {
+		LIT replacement = NOLIT;
 
-			/*
-			 *if the clause is not sat, and literal = watched1 or literal = watched2,
-			  it means that watched1 is falsified, need to replace it by a unassigned literal
-			  if available
-			 */
+		for ( int k = 0; k < clause -> NumAtom; k++ ) {
 
-			 if ( watched1 -> VAR == var && watched1 -> VAL == val  && watched1 -> EQUAL == equals ) {
-				SwapPointer ( current -> c_num );
+			LIT literal = clause -> ATOM_LIST[k];
 
+			if ( literal != watched1 && literal != watched2 && sat ( literal ) != 0 ) {
+				replacement = literal;
+				break;
+			}
+		}
 
-			} else if ( watched2 -> VAR == var && watched2 -> VAL == val  && watched2 -> EQUAL == equals ) {
+		if ( replacement ) {
 
-				SwapPointer ( current -> c_num);
+			clause -> WATCHED[1] = replacement;
+			VARLIST[litVar ( replacement )] -> ATOMWATCH[litVal ( replacement )] = 2;
 
-			}
+			if ( litEqual ( replacement ) ) VARLIST[litVar ( replacement )] -> WATCHPOS[litVal ( replacement )].push_back ( c_num );
+			else VARLIST[litVar ( replacement )] -> WATCHNEG[litVal ( replacement )].push_back ( c_num );
+			continue;
 		}
-		current = current -> next;
-	}
 
-	current = NULL;
+		// no replacement: the clause is either unit on watched1 or conflicting
 
+		watches[j++] = c_num;
+
+		if ( sat ( watched1 ) == 0 ) {
+			if ( LOG ) cout << "Conflict" << endl;
+			CONFLICT = true;
+			CONFLICTINGCLAUSE = c_num;
+		}
+		else UNITLIST.push_back ( c_num );
+	}
+
+	watches.resize ( j );
 }
 
 
@@ -1210,19 +1935,19 @@ inline void Formula::tempwatchedFalsifyLiteral ( int var, bool equals, int val )
 
 
 //	cout << "Falsifying " << var << ( equals ? "=" : "!" ) << val << endl;
-	VARRECORD* current = NULL;
 
 	// Go through all occurrences of the literal in clauses and update watched literals
 
-	if ( equals ) current = VARLIST[var] -> ATOMRECPOS[val];
-	else current = VARLIST[var] -> ATOMRECNEG[val];
+	OCCLIST & occurrences = equals ? VARLIST[var] -> ATOMRECPOS[val] : VARLIST[var] -> ATOMRECNEG[val];
+
+	for ( int k = 0; k < occurrences.size(); k++ ) {
 
-	while ( current ) {
+		int c_num = occurrences[k];
 
-		Clause* clause = CLAUSELIST[current -> c_num];
+		Clause* clause = CLAUSELIST[c_num];
 
-		Literal* watched1 = clause -> ATOM_LIST[clause -> W1];
-		Literal* watched2 = NULL;
+		LIT watched1 = clause -> ATOM_LIST[clause -> W1];
+		LIT watched2 = NOLIT;
 
 		if ( clause -> W2 != -1) {
 
@@ -1230,7 +1955,7 @@ inline void Formula::tempwatchedFalsifyLiteral ( int var, bool equals, int val )
 
 		}
 
-		if ( sat ( watched1 ) != 1 &&  watched2 != NULL && ! supported ( var, clause ) )  {
+		if ( sat ( watched1 ) != 1 &&  watched2 != NOLIT && ! supported ( var, clause ) )  {
 
 			 // if supported there is a satisfying value for a clause, no need to manage watched literals
 
@@ -1239,46 +1964,60 @@ inline void Formula::tempwatchedFalsifyLiteral ( int var, bool equals, int val )
 			 *if the clause is not sat, and  domainsize - counter <= domainsize - appearances of the var in the clause, means need to assign a literal with a different var to watch
 			 */
 
-			 if ( ( ( watched1 -> VAR == var && watched1 -> VAL == val  && watched1 -> EQUAL == equals  ) ||
-					 ( watched2 -> VAR == var && watched2 -> VAL == val  && watched2 -> EQUAL == equals ) )
+			 if ( ( ( litVar ( watched1 ) == var && litVal ( watched1 ) == val  && litEqual ( watched1 ) == equals  ) ||
+					 ( litVar ( watched2 ) == var && litVal ( watched2 ) == val  && litEqual ( watched2 ) == equals ) )
 					 ) {
-				tempSwapPointer ( current -> c_num );
+				tempSwapPointer ( c_num );
 
 			}
 		}
-		current = current -> next;
 	}
 
-	current = NULL;
 
 }
 
-void Formula::watchedUndoTheory ( int level ) { // FIXME  fixed ?
+void Formula::watchedUndoTheory ( int level ) {
 
-	for ( unsigned int  i = 1; i < VARLIST.size(); i++ ) {
+	// watches need no update on backtracking, only the assignment is popped from the trail;
+	// the COUNTER of the -cmv engine is left as it is, as it always was
 
-		for ( int j = 0; j < VARLIST[i] -> DOMAINSIZE; j++ ) {
-			//if this domain has been assigned at level this or greater undo
-			if ( VARLIST[i]->ATOMLEVEL[j] > level ) {
+	// the clauses skipped by the decision of the next level were skipped at this level
+	if ( (int) DECIDEFROMLIM.size() > level + 1 ) {
+		DECIDEFROM = DECIDEFROMLIM[level + 1];
+		DECIDEFROMLIM.resize ( level + 1 );
+	}
 
-				// cout << "unassign " << i << " " << j <<endl;
-				VARLIST[i] -> LEVEL = -1;
-				VARLIST[i] -> SAT = false;
-				VARLIST[i] -> VAL = -1;
-				VARLIST[i]->ATOMASSIGN[j] = 0;
-				VARLIST[i]->ATOMLEVEL[j] = -1;
-				VARLIST[i]->CLAUSEID[j] = -10;
+	if ( (int) TRAILLIM.size() <= level + 1 ) return;
 
-			}
+	int stop = TRAILLIM[level + 1];
+	undoConstraints ( stop );
+
+	for ( int t = TRAIL.size() - 1; t >= stop; t-- ) {
+
+		int var = TRAIL[t].var;
+		int val = TRAIL[t].val;
+
+		VARLIST[var] -> ATOMASSIGN[val] = 0;
+		VARLIST[var] -> ATOMLEVEL[val] = -10;
+		VARLIST[var] -> CLAUSEID[val] = -10;
+
+		if ( EVSIDS || WATCH ) ATOMHEAP.insert ( ATOMBASE[var] + val );
+
+		if ( VARLIST[var] -> LEVEL > level ) {
+
+			if ( VARLIST[var] -> VAL != -1 ) VARLIST[var] -> SAVED = VARLIST[var] -> VAL;
+			VARLIST[var] -> LEVEL = -1;
+			VARLIST[var] -> SAT = false;
+			VARLIST[var] -> VAL = -1;
 		}
 	}
+
+	TRAIL.resize ( stop );
+	TRAILLIM.resize ( level + 1 );
+
 	//undo the decision stack
-	int decsize = DECSTACK.size();
-	for ( int i = decsize - 1; i > -1; i-- ) {
-		if ( VARLIST[DECSTACK[i] -> VAR] -> ATOMASSIGN[DECSTACK[i] -> VAL] == 0 ) {
-			DECSTACK.erase ( DECSTACK.begin() + i );
-		}
-	}
+	while ( ! DECSTACK.empty() && VARLIST[litVar ( DECSTACK.back() )] -> ATOMASSIGN[litVal ( DECSTACK.back() )] == 0 )
+		DECSTACK.pop_back ();
 }
 
 void Formula::assignWatched (Clause* clause ) {
@@ -1287,30 +2026,30 @@ void Formula::assignWatched (Clause* clause ) {
 
 			if ( LOG ) {
 				cout << "Latest falsified literal (now watched): " << endl;
-				clause -> ATOM_LIST[LASTFALSE] -> Print ();
+				printLit ( clause -> ATOM_LIST[LASTFALSE] );
 				cout << "Watched literal 1:"<<endl;
-				clause -> WATCHED[0] -> Print();
+				printLit ( clause -> WATCHED[0] );
 			}
 
-			Literal* watched1 = clause -> WATCHED[0];
+			LIT watched1 = clause -> WATCHED[0];
 
-			VARLIST[watched1 -> VAR] ->  ATOMWATCH[watched1 -> VAL] = 1;
+			VARLIST[litVar ( watched1 )] ->  ATOMWATCH[litVal ( watched1 )] = 1;
 
 			if ( clause -> NumAtom == 1 ) {
-				clause -> WATCHED[1]  = NULL;
+				clause -> WATCHED[1]  = NOLIT;
 			}
 
 			else if ( LASTFALSE < clause -> NumAtom - 1) {
 
 				clause -> WATCHED[1] = clause -> ATOM_LIST[LASTFALSE + 1];
-				Literal* watched2 = clause -> WATCHED[1];
-				VARLIST[watched2 -> VAR] ->  ATOMWATCH[watched2 -> VAL] = 1;
+				LIT watched2 = clause -> WATCHED[1];
+				VARLIST[litVar ( watched2 )] ->  ATOMWATCH[litVal ( watched2 )] = 1;
 
 			}
 			else {
 				clause -> WATCHED[1] = clause -> ATOM_LIST[LASTFALSE - 1];
-				Literal* watched2 = clause -> WATCHED[1];
-				VARLIST[watched2 -> VAR] ->  ATOMWATCH[watched2 -> VAL] = 1;
+				LIT watched2 = clause -> WATCHED[1];
+				VARLIST[litVar ( watched2 )] ->  ATOMWATCH[litVal ( watched2 )] = 1;
 
 			}
 
@@ -1328,13 +2067,13 @@ void Formula::tempassignWatched ( Clause* clause ) {
 
 	if ( LOG ) {
 		cout << "Latest falsified literal (now watched): " << endl;
-		clause -> ATOM_LIST[clause -> W1] -> Print ();
+		printLit ( clause -> ATOM_LIST[clause -> W1] );
 
 	}
 
-	Literal* watched1 =  clause -> ATOM_LIST[clause -> W1];
+	LIT watched1 =  clause -> ATOM_LIST[clause -> W1];
 
-	VARLIST[watched1 -> VAR] ->  ATOMWATCH[watched1 -> VAL] = 1;
+	VARLIST[litVar ( watched1 )] ->  ATOMWATCH[litVal ( watched1 )] = 1;
 
 	if ( clause -> NumAtom == 1 ) clause -> W2  = -1;
 
@@ -1344,7 +2083,7 @@ void Formula::tempassignWatched ( Clause* clause ) {
 
 		// start looking for a w2 from w1, then wrap around the tail:
 
-		Literal* literal = NULL;
+		LIT literal = NOLIT;
 
 		for ( int i = clause -> W1 + 1; i < clause -> NumAtom; i++ ) {
 
@@ -1352,11 +2091,11 @@ void Formula::tempassignWatched ( Clause* clause ) {
 
 			clause -> W2 = i;
 
-			if ( literal -> VAR != watched1 -> VAR) {
+			if ( litVar ( literal ) != litVar ( watched1 )) {
 
 				// clause -> watched2 = i;
 
-				VARLIST[literal -> VAR] -> ATOMWATCH[literal -> VAL] = 2;
+				VARLIST[litVar ( literal )] -> ATOMWATCH[litVal ( literal )] = 2;
 				flag = true;
 				break;
 
@@ -1372,12 +2111,12 @@ void Formula::tempassignWatched ( Clause* clause ) {
 				clause -> W2 = i;
 
 
-				if ( literal -> VAR != watched1 -> VAR) {
+				if ( litVar ( literal ) != litVar ( watched1 )) {
 
 
 					// clause -> watched2 = i;
 
-					VARLIST[literal -> VAR] -> ATOMWATCH[literal -> VAL] = 2;
+					VARLIST[litVar ( literal )] -> ATOMWATCH[litVal ( literal )] = 2;
 					break;
 
 				}
@@ -1386,7 +2125,7 @@ void Formula::tempassignWatched ( Clause* clause ) {
 
 		if ( LOG ) {
 				cout << "watched2 in learned clause: " << endl;
-				clause -> ATOM_LIST[clause -> W2] -> Print ();
+				printLit ( clause -> ATOM_LIST[clause -> W2] );
 
 			}
 
@@ -1397,215 +2136,882 @@ void Formula::tempassignWatched ( Clause* clause ) {
 
 //--------------- Resolution-based clause learning ---------------------//
 
-Clause* Formula::analyzeConflict ( Clause * clause ) {
+Clause* Formula::analyzeConflict ( int conflict ) {
 
 	/*
-    First check if there is exactly one atom falsified at the current level.
-    If yes, learn the clause: this way upon backtrack it becomes unit. Otherwise
-    continue analyzing the conflict.
+    Resolve the clause with the reason of its latest falsified literal until exactly
+    one atom is falsified at the current level, the first unique implication point.
+    Then learn the clause: this way upon backtrack it becomes unit. The resolvents
+    are built in the RESOLVENT buffer, only the learned clause is allocated.
 	 */
 
-	if ( potent ( clause ) ) {
+	Clause * clause;
+	if ( conflict <= AMOREASON ) conflictAtMostOne ( AMOREASON - conflict );
+	else {
+		clause = CLAUSELIST[conflict];
+		RESOLVENT.assign ( clause -> ATOM_LIST, clause -> ATOM_LIST + clause -> NumAtom );
+		countImported ( clause );
+	}
+
+	while ( ! RESOLVENT.empty() ) {
 
-		// After backtracking the clause should be detected as unit
-		clause -> NumUnAss = 0;
+		// count the atoms falsified at the current level, and find the latest falsified
+		// literal with the position of its falsifier in the decision stack
+
+		int counter = 0;
+		int last = 0;
+		int maxIndex = 0;
+
+		for ( unsigned int i = 0; i < RESOLVENT.size(); i++ ) {
+
+			Variable * variable = VARLIST[litVar ( RESOLVENT[i] )];
+			int val = litVal ( RESOLVENT[i] );
+
+			if ( variable -> ATOMLEVEL[val] == LEVEL ) {
+				counter++;
+				LASTFALSE = i;
+			}
+			if ( maxIndex < variable -> ATOMINDEX[val] ) {
+				maxIndex = variable -> ATOMINDEX[val];
+				last = i;
+			}
+		}
+
+		if ( counter == 1 ) break;
+
+		LIT lastFalse = RESOLVENT[last];
+		int var = litVar ( lastFalse );
+		int val = litVal ( lastFalse );
+
+		if ( LOG ) {
+			cout << "Latest falsified literal: " << endl;
+			printLit ( lastFalse );
+			cout << "It's reason: " << endl;
+			cout << VARLIST[var]-> CLAUSEID[val] << endl;
+		}
+
+		// Generate reasons for decision and entail reasons:
+
+		if ( VARLIST[var]-> CLAUSEID[val] == -1 ) {
+			// Take literal in the decstack that falsified lastFalse
+			LIT falsifier = DECSTACK[maxIndex];
+
+			REASON.clear();
+			REASON.push_back ( makeLit ( litVar ( falsifier ), true, litVal ( falsifier ) ) );
+			REASON.push_back ( makeLit ( litVar ( falsifier ), false, litVal ( falsifier ) ) );
+			resolve ( lastFalse, &REASON[0], REASON.size() );
+
+		} else if ( VARLIST[var] -> CLAUSEID[val] == -2 ) {
+
+			REASON.clear();
+			for ( int i = 0; i < VARLIST[var] -> DOMAINSIZE; i++ )
+				REASON.push_back ( makeLit ( var, true, i ) );
+			resolve ( lastFalse, &REASON[0], REASON.size() );
+
+		} else if ( VARLIST[var] -> CLAUSEID[val] <= AMOREASON ) {
+
+			explainAtMostOne ( AMOREASON - VARLIST[var] -> CLAUSEID[val], var, val );
+			resolve ( lastFalse, &REASON[0], REASON.size() );
+
+		} else {
+			Clause * reason = CLAUSELIST[VARLIST[var] -> CLAUSEID[val]];
+			if ( VARLIST[var] -> CLAUSEID[val] >= ORIGINALCLAUSES ) bumpClause ( reason );
+			countImported ( reason );
+			resolve ( lastFalse, reason -> ATOM_LIST, reason -> NumAtom );
+		}
 
 		if (LOG) {
-			cout << "Learned a clause: " << endl;
-			clause->Print();
-		}
-		// add the clause to the clause list
-		CLAUSELIST.push_back( clause );
-		// it's id
-		int cid = CLAUSELIST.size()-1;
-		// update global records for each atom in the clause
-		for ( int i = 0; i < clause -> NumAtom; i++ ) {
-			Literal* atom = clause->ATOM_LIST[i];
-			VARLIST[atom->VAR] -> addRecord( cid, atom->VAL, atom->EQUAL);
+			cout << "Resolvent:" << endl;
+			for ( unsigned int i = 0; i < RESOLVENT.size(); i++ ) printLit ( RESOLVENT[i] );
+		}
+	}
+
+	// Learn the resolvent, stored in the arena
+
+	clause = new Clause ( ARENA.alloc ( RESOLVENT.size() ), RESOLVENT.size() );
+	for ( unsigned int i = 0; i < RESOLVENT.size(); i++ )
+		clause -> ATOM_LIST[i] = RESOLVENT[i];
+
+	// An empty resolvent means the theory is unsatisfiable, nothing to learn
+
+	if ( clause -> NumAtom == 0 ) return clause;
+
+	// After backtracking the clause should be detected as unit
+	clause -> NumUnAss = 0;
+
+	clause -> LBD = computeLBD ( clause );
+	bumpClause ( clause );
+	LEARNEDCLAUSES++;
+	if ( EXCHANGE ) exportClause ( clause );
+
+	if (LOG) {
+		cout << "Learned a clause: " << endl;
+		clause->Print();
+	}
+	// add the clause to the clause list
+	CLAUSELIST.push_back( clause );
+	UNSATCLAUSES++;
+	// it's id
+	int cid = CLAUSELIST.size()-1;
+	// update global records for each atom in the clause
+	for ( int i = 0; i < clause -> NumAtom; i++ ) {
+		LIT atom = clause->ATOM_LIST[i];
+		VARLIST[litVar ( atom )] -> addRecord( cid, litVal ( atom ), litEqual ( atom ));
 
 		if ( VSIDS )
-				VARLIST[atom->VAR]->VSIDSCOUNTER[atom->VAL]++;
+			VARLIST[litVar ( atom )]->VSIDSCOUNTER[litVal ( atom )]++;
+		if ( EVSIDS )
+			ATOMHEAP.bump ( ATOMBASE[litVar ( atom )] + litVal ( atom ) );
+	}
+
+	if ( WATCH ) {
+		clause -> WATCHED[0] = clause -> ATOM_LIST[LASTFALSE]; //  assignWatched ( clause );
+		if ( clause -> NumAtom == 1 ) {
+			clause -> WATCHED[1]  = NOLIT;
 		}
+	}
 
-		if ( WATCH ) {
-			clause -> WATCHED[0] = clause -> ATOM_LIST[LASTFALSE]; //  assignWatched ( clause );
-			if ( clause -> NumAtom == 1 ) {
-							clause -> WATCHED[1]  = NULL;
-						}
+	if ( CMV ) {
+		clause -> W1 = LASTFALSE; // tempassignWatched ( clause );
+		if ( clause -> NumAtom == 1 ) {
+			clause -> W2  = -1;
 		}
+	}
 
-		if ( CMV ) {
-			clause -> W1 = LASTFALSE; // tempassignWatched ( clause );
-			if ( clause -> NumAtom == 1 ) {
-									clause -> W2  = -1;
-								}
+	if ( VSIDS ) {
+		for ( int i = 0; i < VARLIST.size(); i++ ) {
+			for ( int j = 0; j < VARLIST[i] -> DOMAINSIZE; j++ ) {
+				VARLIST[i] -> VSIDSCOUNTER[j] /= 2;
+			}
 		}
+	}
 
-		if ( VSIDS ) {
-			for ( int i = 0; i < VARLIST.size(); i++ ) {
-				for ( int j = 0; j < VARLIST[i] -> DOMAINSIZE; j++ ) {
-					VARLIST[i] -> VSIDSCOUNTER[j] /= 2;
-				}
+	if ( EVSIDS ) ATOMHEAP.decay();
+
+	CLAUSEINC /= CLAUSEDECAY;
+
+	return clause;
+}
+
+void Formula::exportClause ( Clause * clause ) {
+
+	// short clauses and clauses over few levels are worth sending to the other searches
+
+	if ( clause -> NumAtom > SHAREMAXSIZE ) return;
+	if ( clause -> NumAtom > SHARESIZE && clause -> LBD > SHARELBD ) return;
+
+	EXCHANGE -> publish ( SHAREID, clause -> ATOM_LIST, clause -> NumAtom, clause -> LBD );
+	EXPORTED++;
+}
+
+void Formula::importClauses () {
+
+	/*
+	 Add the clauses learned by the other searches since the last import. Only the
+	 atoms assigned at the level 0 are assigned, so every imported clause is either
+	 satisfied for good, or unit, or falsified, which makes the theory unsatisfiable,
+	 or has two unassigned literals to watch.
+	 */
+
+	IMPORTATOMS.clear();
+	IMPORTSIZES.clear();
+	IMPORTLBDS.clear();
+	EXCHANGE -> collect ( SHAREID, IMPORTATOMS, IMPORTSIZES, IMPORTLBDS );
+
+	const LIT * atoms = IMPORTATOMS.empty() ? NULL : &IMPORTATOMS[0];
+	for ( unsigned int k = 0; k < IMPORTSIZES.size(); atoms += IMPORTSIZES[k++] ) {
+
+		Clause * clause = CLAUSELIST[attachClause ( atoms, IMPORTSIZES[k], ARENA )];
+		clause -> LBD = IMPORTLBDS[k];
+		clause -> IMPORTED = true;
+		bumpClause ( clause );
+		IMPORTED++;
+
+		if ( CONFLICT ) return;
+	}
+}
+
+int Formula::attachClause ( const LIT * atoms, int size, ClauseArena & arena ) {
+
+	/*
+	 Only the atoms assigned at the level 0 are assigned, so the clause is either
+	 satisfied for good, or unit, or falsified, which makes the theory unsatisfiable,
+	 or has two unassigned literals to watch.
+	 */
+
+	Clause * clause = new Clause ( arena.alloc ( size ), size );
+	clause -> NumUnAss = 0;
+
+		// the satisfied and unassigned literals go first, to be watched
+
+		int free = 0;
+		bool satisfied = false;
+		for ( int i = 0; i < size; i++ ) {
+			int value = sat ( atoms[i] );
+			if ( value == 1 ) satisfied = true;
+			if ( value != 0 ) {
+				clause -> ATOM_LIST[i] = clause -> ATOM_LIST[free];
+				clause -> ATOM_LIST[free++] = atoms[i];
 			}
+			else clause -> ATOM_LIST[i] = atoms[i];
+			if ( value == 2 ) clause -> NumUnAss++;
 		}
 
-		return clause;
+	CLAUSELIST.push_back ( clause );
+	int cid = CLAUSELIST.size() - 1;
 
+	for ( int i = 0; i < size; i++ )
+		VARLIST[litVar ( clause -> ATOM_LIST[i] )] -> addRecord ( cid, litVal ( clause -> ATOM_LIST[i] ), litEqual ( clause -> ATOM_LIST[i] ) );
+
+	if ( WATCH ) {
+		UNSATCLAUSES++;
+		clause -> WATCHED[0] = clause -> ATOM_LIST[0];
+		clause -> WATCHED[1] = size > 1 ? clause -> ATOM_LIST[1] : NOLIT;
+		watchClause ( cid );
+		// a unit or a conflict is found by the unit propagation
+		if ( ! satisfied && free < 2 ) UNITLIST.push_back ( cid );
+	}
+	else if ( satisfied ) {
+		clause -> SAT = true;
+		clause -> LEVEL = 0;
 	}
+	else {
+		// the unassigned literals of unsatisfied clauses are counted
+		UNSATCLAUSES++;
+		for ( int i = 0; i < free; i++ ) {
+			LIT atom = clause -> ATOM_LIST[i];
+			if ( litEqual ( atom ) ) VARLIST[litVar ( atom )] -> ATOMCNTPOS[litVal ( atom )]++;
+			else VARLIST[litVar ( atom )] -> ATOMCNTNEG[litVal ( atom )]++;
+		}
+		checkUnit ( cid );
+	}
+	return cid;
+}
 
-	// Resolve the clause and its latest falsified literal's reason
-	// Latest falsified literal in the clause:
-	Literal* lastFalse = clause -> ATOM_LIST[maxLit ( clause )[0]];
-	int var = lastFalse -> VAR;
-	int val = lastFalse -> VAL;
-	Clause * resolvent = new Clause();
+void Formula::addRootClauses ( const vector <LIT> & atoms, const vector <int> & sizes ) {
 
-	if ( LOG ) {
-		cout << "Latest falsified literal: " << endl;
-		lastFalse -> Print ();
-		cout << "It's reason: " << endl;
-		cout << VARLIST[var]-> CLAUSEID[val] << endl;
+	/*
+	 The new clauses of the input are attached after the learned clauses, then moved
+	 in front of them, so reduceDB never deletes them. The learned clauses are
+	 renumbered once for all the new clauses, the way reduceDB renumbers them.
+	 */
+
+	int learned = CLAUSELIST.size() - ORIGINALCLAUSES;
+	int added = sizes.size();
+
+	const LIT * p = atoms.empty() ? NULL : &atoms[0];
+	for ( int k = 0; k < added; p += sizes[k++] )
+		attachClause ( p, sizes[k], INPUTARENA );
+
+	vector<int> newId ( learned + added );
+	for ( int c = 0; c < learned; c++ ) newId[c] = ORIGINALCLAUSES + added + c;
+	for ( int k = 0; k < added; k++ ) newId[learned + k] = ORIGINALCLAUSES + k;
+
+	rotate ( CLAUSELIST.begin() + ORIGINALCLAUSES, CLAUSELIST.begin() + ORIGINALCLAUSES + learned, CLAUSELIST.end() );
+	renumberTheory ( newId );
+	for ( list<int>::iterator u = UNITLIST.begin(); u != UNITLIST.end(); ++u )
+		if ( *u >= ORIGINALCLAUSES ) *u = newId[*u - ORIGINALCLAUSES];
+	if ( CONFLICT && CONFLICTINGCLAUSE >= ORIGINALCLAUSES )
+		CONFLICTINGCLAUSE = newId[CONFLICTINGCLAUSE - ORIGINALCLAUSES];
+
+	ORIGINALCLAUSES += added;
+	// attachClause leaves the watches of the -cmv engine to initWatches
+	if ( CMV )
+		for ( int c = ORIGINALCLAUSES - added; c < ORIGINALCLAUSES; c++ )
+			initWatches ( c );
+}
+
+void Formula::addVariable ( int domainsize ) {
+
+	// the atoms are numbered var by var, so those of the new variable come last
+	// and the activities of the others keep their numbers
+
+	VARLIST.push_back ( new Variable ( VARLIST.size(), domainsize ) );
+	numberAtoms();
+
+	if ( EVSIDS || WATCH ) {
+		int var = VARLIST.size() - 1;
+		ATOMHEAP.grow ( SEEN.size() / 2 );
+		for ( int j = 0; j < domainsize; j++ ) {
+			HEAPLIT.push_back ( makeLit ( var, true, j ) );
+			ATOMHEAP.insert ( ATOMBASE[var] + j );
+		}
+	}
+}
+
+void Formula::addConstraint ( Constraint * constraint ) {
+
+	// the constraint is propagated once first, at the level 0
+
+	int c = CONSTRAINTS.size();
+	CONSTRAINTS.push_back ( constraint );
+	VARCONSTRAINTS.resize ( VARLIST.size() );
+	for ( unsigned int i = 0; i < constraint -> VARS.size(); i++ )
+		VARCONSTRAINTS[constraint -> VARS[i]].push_back ( c );
+	DIRTY.push_back ( c );
+	ISDIRTY.push_back ( true );
+}
+
+void Formula::addAllDifferent ( const vector <int> & vars ) {
+
+	addConstraint ( new AllDifferent ( vars, VARLIST ) );
+}
+
+void Formula::addTable ( const vector <int> & vars, const vector <int> & tuples ) {
+
+	addConstraint ( new Table ( vars, tuples, VARLIST ) );
+}
+
+void Formula::addAtMostOne ( const vector <LIT> & atoms ) {
+
+	// each literal of the constraint is watched by its number in the domain of its
+	// variable, the search has not started yet so no atom is counted
+
+	int c = AMOS.size();
+	AMOS.push_back ( new AtMostOne ( atoms ) );
+	LITAMOS.resize ( VARLIST.size() );
+	for ( unsigned int i = 0; i < atoms.size(); i++ ) {
+		int var = litVar ( atoms[i] );
+		LITAMOS[var].resize ( 2 * VARLIST[var] -> DOMAINSIZE );
+		LITAMOS[var][2 * litVal ( atoms[i] ) + litEqual ( atoms[i] )].push_back ( c );
+	}
+}
+
+void Formula::undoConstraints ( int stop ) {
+
+	// the atoms counted by the at most one constraints are uncounted latest first,
+	// while their assignment still says which literal of them held
+
+	for ( int t = CONSTRAINTTRAIL - 1; t >= stop; t-- ) {
+		int var = TRAIL[t].var;
+		int val = TRAIL[t].val;
+		if ( var >= (int) LITAMOS.size() || LITAMOS[var].empty() ) continue;
+		vector <int> & constraints = LITAMOS[var][2 * val + ( VARLIST[var] -> ATOMASSIGN[val] == 1 )];
+		for ( unsigned int k = 0; k < constraints.size(); k++ )
+			AMOS[constraints[k]] -> unassign();
 	}
+	if ( CONSTRAINTTRAIL > stop ) CONSTRAINTTRAIL = stop;
 
-	// Generate reasons for decision and entail reasons:
-	Clause* reason = new Clause ();
+	// the other constraints forget what they propagated after stop
 
-	if ( VARLIST[var]-> CLAUSEID[val] == -1 ) {
-		// Take literal in the decstack that falsified lastFalse
-		Literal * falsifier = DECSTACK[maxLit ( clause )[1]];
+	while ( ! PROPAGATED.empty() && PROPAGATED.back().first > stop ) {
+		CONSTRAINTS[PROPAGATED.back().second] -> undo ( stop );
+		PROPAGATED.pop_back();
+	}
+}
 
-		// Generate the reason clause:
-		reason -> addAtom ( new Literal ( falsifier -> VAR, '=', falsifier -> VAL ) );
-		reason -> addAtom ( new Literal ( falsifier -> VAR, '!', falsifier -> VAL ) );
+bool Formula::propagateConstraints () {
 
-	} else if ( VARLIST[var] -> CLAUSEID[val] == -2 ) {
+	/*
+	 Each value an alldifferent or table constraint takes from a variable comes with a
+	 clause, unit on the atom taken away, and a conflict of such a constraint with a
+	 falsified clause. Once added, the clauses are propagated and resolved like the
+	 learned clauses, and the reasons of the atoms stay in CLAUSELIST. An at most one
+	 constraint assigns the atoms it falsifies itself, with AMOREASON - c as their
+	 reason, and the conflict analysis builds their clauses when it resolves on them.
+	 A search decides only once the constraints have nothing more to say, so after a
+	 backtrack they only need to see the atoms assigned since.
+	 */
 
-		for ( int i = 0; i < VARLIST[var] -> DOMAINSIZE; i++ ) {
-			reason -> addAtom ( new Literal ( var, '=', i ) );
+	if ( CONSTRAINTS.empty() && AMOS.empty() ) return false;
+
+	EXPLAINATOMS.clear();
+	EXPLAINSIZES.clear();
+	vector <LIT> falsified;
+	bool conflict = false;
+	bool assigned = false;
+	while ( ! conflict && ! CONFLICT && CONSTRAINTTRAIL < (int) TRAIL.size() ) {
+
+		int var = TRAIL[CONSTRAINTTRAIL].var;
+		int val = TRAIL[CONSTRAINTTRAIL].val;
+		CONSTRAINTTRAIL++;
+
+		if ( var < (int) VARCONSTRAINTS.size() ) {
+			vector <int> & constraints = VARCONSTRAINTS[var];
+			for ( unsigned int k = 0; k < constraints.size(); k++ ) {
+				if ( ISDIRTY[constraints[k]] ) continue;
+				ISDIRTY[constraints[k]] = true;
+				DIRTY.push_back ( constraints[k] );
+			}
+		}
+
+		// the at most one constraints count the literal of the atom that holds, all
+		// of them, since undoConstraints uncounts it from all of them, and falsify
+		// the other atoms until there is a conflict
+
+		if ( var < (int) LITAMOS.size() && ! LITAMOS[var].empty() ) {
+			bool equals = VARLIST[var] -> ATOMASSIGN[val] == 1;
+			vector <int> & constraints = LITAMOS[var][2 * val + equals];
+			for ( unsigned int k = 0; k < constraints.size(); k++ ) {
+				AMOFALSIFIED.clear();
+				if ( ! AMOS[constraints[k]] -> assign ( VARLIST, makeLit ( var, equals, val ), AMOFALSIFIED ) ) {
+					if ( ! conflict && ! CONFLICT ) {
+						CONFLICT = true;
+						CONFLICTINGCLAUSE = AMOREASON - constraints[k];
+					}
+					conflict = true;
+				}
+				// the negation of a literal differs in the bit of = and !
+				for ( unsigned int i = 0; i < AMOFALSIFIED.size() && ! CONFLICT; i++ ) {
+					if ( sat ( AMOFALSIFIED[i] ) != 2 ) continue;
+					assignReason ( AMOFALSIFIED[i] ^ 1, AMOREASON - constraints[k] );
+					assigned = true;
+				}
+			}
 		}
-	} else {
-		reason = CLAUSELIST[VARLIST[var] -> CLAUSEID[val]];
 	}
 
-	// resolve:
-	resolvent = resolve ( clause, lastFalse, reason );
+	// a conflict of the clauses or of an at most one constraint is left to the search
+	if ( conflict || CONFLICT ) return true;
 
-	//cout << "Clause size: " << resolvent -> NumAtom << endl;
+	while ( ! conflict && ! DIRTY.empty() ) {
 
-	if (LOG) {
-		cout << "Resolvent:" << endl;
-		resolvent -> Print();
+		int c = DIRTY.back();
+		DIRTY.pop_back();
+		ISDIRTY[c] = false;
+
+		if ( PROPAGATED.empty() || PROPAGATED.back() != make_pair ( CONSTRAINTTRAIL, c ) )
+			PROPAGATED.push_back ( make_pair ( CONSTRAINTTRAIL, c ) );
+		if ( ! CONSTRAINTS[c] -> propagate ( VARLIST, CONSTRAINTTRAIL, EXPLAINATOMS, EXPLAINSIZES ) ) {
+			conflict = true;
+			falsified.assign ( EXPLAINATOMS.end() - EXPLAINSIZES.back(), EXPLAINATOMS.end() );
+		}
 	}
-	return analyzeConflict ( resolvent );
+
+	// a conflict is all there is to add, the other constraints wait for the backtrack
+
+	if ( conflict ) {
+		EXPLAINATOMS.swap ( falsified );
+		EXPLAINSIZES.assign ( 1, EXPLAINATOMS.size() );
+	}
+
+	const LIT * atoms = EXPLAINATOMS.empty() ? NULL : &EXPLAINATOMS[0];
+	for ( unsigned int k = 0; k < EXPLAINSIZES.size(); atoms += EXPLAINSIZES[k++] )
+		addExplanation ( atoms, EXPLAINSIZES[k] );
+
+	if ( LOG && ! EXPLAINSIZES.empty() ) cout << "The constraints added " << EXPLAINSIZES.size() << " clauses" << endl;
+	return assigned || ! EXPLAINSIZES.empty();
 }
 
+void Formula::assignReason ( LIT atom, int reason ) {
 
-//Finding the literal falsified the latest in the clause
-vector<int> Formula::maxLit ( Clause* clause ) {
+	// what the unit propagation of a clause does, the reason standing for the clause
 
-	vector<int> result;
-	result.reserve(2);
+	UNITCLAUSE = reason;
+	if ( WATCH ) watchedReduceTheory ( atom, litVar ( atom ), litEqual ( atom ), litVal ( atom ) );
+	else reduceTheory ( litVar ( atom ), litEqual ( atom ), litVal ( atom ) );
+	UNITS++;
+}
 
-	int atom_index = 0;
-	int decision_index = 0;
-	int max_decision_index = 0;
+void Formula::explainAtMostOne ( int c, int var, int val ) {
 
-	for ( int i = 0; i < clause -> NumAtom; i++ ) {
+	/*
+	 The constraint falsified one of its atoms, either var=val or var!=VAL, which is how
+	 var!=val got its reason as the other values of var do. The atom that holds in the
+	 constraint was assigned before it, and the clause of the two atoms is the reason.
+	 */
 
-		Literal * atom = clause -> ATOM_LIST[i];
+	vector <int> & amos = LITAMOS[var][2 * val + 1];
+	bool atom = VARLIST[var] -> ATOMASSIGN[val] == -1 && find ( amos.begin(), amos.end(), c ) != amos.end();
 
-		decision_index = VARLIST[atom -> VAR] -> ATOMINDEX[atom -> VAL];
+	REASON.clear();
+	REASON.push_back ( AMOS[c] -> TRUEATOM ^ 1 );
+	REASON.push_back ( atom ? makeLit ( var, false, val ) : makeLit ( var, true, VARLIST[var] -> VAL ) );
+}
+
+void Formula::conflictAtMostOne ( int c ) {
 
-		if ( max_decision_index < decision_index ) {
+	// the atom counted first and the latest assigned other atom that holds, which is
+	// the one of the current level whose count made the conflict
 
-			max_decision_index = decision_index;
-			atom_index = i;
+	AtMostOne * amo = AMOS[c];
+	LIT latest = NOLIT;
+	int index = -1;
+	for ( unsigned int i = 0; i < amo -> ATOMS.size(); i++ ) {
+		LIT atom = amo -> ATOMS[i];
+		if ( atom == amo -> TRUEATOM || sat ( atom ) != 1 ) continue;
+		if ( VARLIST[litVar ( atom )] -> ATOMINDEX[litVal ( atom )] > index ) {
+			index = VARLIST[litVar ( atom )] -> ATOMINDEX[litVal ( atom )];
+			latest = atom;
 		}
+	}
 
+	RESOLVENT.clear();
+	RESOLVENT.push_back ( amo -> TRUEATOM ^ 1 );
+	RESOLVENT.push_back ( latest ^ 1 );
+}
+
+void Formula::addExplanation ( const LIT * atoms, int size ) {
+
+	/*
+	 The clause is unit or falsified under the current assignment. The unassigned atom
+	 goes first, then the falsified atom of the highest level, so the watches hold as
+	 for a learned clause: the second one is the first to be unassigned on backtracking.
+	 */
+
+	Clause * clause = new Clause ( ARENA.alloc ( size ), size );
+	for ( int i = 0; i < size; i++ )
+		clause -> ATOM_LIST[i] = atoms[i];
+
+	for ( int w = 0; w < 2 && w < size; w++ ) {
+		int best = w;
+		int bestLevel = -1;
+		for ( int i = w; i < size; i++ ) {
+			LIT atom = clause -> ATOM_LIST[i];
+			int level = sat ( atom ) == 2 ? INT_MAX : VARLIST[litVar ( atom )] -> ATOMLEVEL[litVal ( atom )];
+			if ( level > bestLevel ) {
+				bestLevel = level;
+				best = i;
+			}
+		}
+		swap ( clause -> ATOM_LIST[w], clause -> ATOM_LIST[best] );
+	}
+
+	clause -> NumUnAss = 0;
+	clause -> LBD = computeLBD ( clause );
+	bumpClause ( clause );
+	EXPLAINED++;
+
+	CLAUSELIST.push_back ( clause );
+	UNSATCLAUSES++;
+	int cid = CLAUSELIST.size() - 1;
+	for ( int i = 0; i < size; i++ )
+		VARLIST[litVar ( clause -> ATOM_LIST[i] )] -> addRecord ( cid, litVal ( clause -> ATOM_LIST[i] ), litEqual ( clause -> ATOM_LIST[i] ) );
+
+	if ( WATCH ) {
+		clause -> WATCHED[0] = size > 0 ? clause -> ATOM_LIST[0] : NOLIT;
+		clause -> WATCHED[1] = size > 1 ? clause -> ATOM_LIST[1] : NOLIT;
+		watchClause ( cid );
+		if ( size > 0 && sat ( clause -> ATOM_LIST[0] ) == 2 ) UNITLIST.push_back ( cid );
+		else {
+			CONFLICT = true;
+			CONFLICTINGCLAUSE = cid;
+		}
+	}
+	else {
+		for ( int i = 0; i < size; i++ ) {
+			LIT atom = clause -> ATOM_LIST[i];
+			if ( sat ( atom ) != 2 ) continue;
+			clause -> NumUnAss++;
+			if ( litEqual ( atom ) ) VARLIST[litVar ( atom )] -> ATOMCNTPOS[litVal ( atom )]++;
+			else VARLIST[litVar ( atom )] -> ATOMCNTNEG[litVal ( atom )]++;
+		}
+		checkUnit ( cid );
 	}
+}
 
-	result[0] = atom_index; // atom in clause that is falsified last
-	result[1] = max_decision_index; //  falsifier of the atom in the decstack
+bool Formula::constraintsHold () {
 
-	return  result ;
+	// every clause may be satisfied while some variable of a constraint has no value yet
 
+	for ( unsigned int c = 0; c < CONSTRAINTS.size(); c++ )
+		if ( ! CONSTRAINTS[c] -> holds ( VARLIST ) ) return false;
+	for ( unsigned int c = 0; c < AMOS.size(); c++ ) {
+		vector <LIT> & atoms = AMOS[c] -> ATOMS;
+		int holding = 0;
+		for ( unsigned int i = 0; i < atoms.size(); i++ ) {
+			int val = VARLIST[litVar ( atoms[i] )] -> VAL;
+			if ( val < 0 ) return false;
+			if ( ( val == litVal ( atoms[i] ) ) == litEqual ( atoms[i] ) ) holding++;
+		}
+		if ( holding > 1 ) return false;
+	}
+	return true;
 }
 
+void Formula::decomposeConstraints () {
 
-bool Formula::falsifies ( Literal* literal, Literal* decision ) {
+	// each constraint gives the clauses it was written as before, and two atoms of
+	// an at most one never both hold: a clause for each pair
 
-	// true if literal falsifies decision
+	if ( CONSTRAINTS.empty() && AMOS.empty() ) return;
 
-	if ( literal -> VAR != decision -> VAR ) return false;
-	else if ( literal -> VAL != decision -> VAL && literal -> EQUAL != decision -> EQUAL ) return false;
-	else if ( literal -> VAL == decision -> VAL && literal -> EQUAL == decision -> EQUAL ) return false;
+	vector <LIT> atoms;
+	vector <int> sizes;
+	for ( unsigned int c = 0; c < CONSTRAINTS.size(); c++ ) {
+		CONSTRAINTS[c] -> decompose ( VARLIST, atoms, sizes );
+		delete CONSTRAINTS[c];
+	}
+	for ( unsigned int c = 0; c < AMOS.size(); c++ ) {
+		vector <LIT> & lits = AMOS[c] -> ATOMS;
+		for ( unsigned int i = 0; i < lits.size(); i++ )
+			for ( unsigned int j = i + 1; j < lits.size(); j++ ) {
+				atoms.push_back ( lits[i] ^ 1 );
+				atoms.push_back ( lits[j] ^ 1 );
+				sizes.push_back ( 2 );
+			}
+		delete AMOS[c];
+	}
+	CONSTRAINTS.clear();
+	VARCONSTRAINTS.clear();
+	PROPAGATED.clear();
+	DIRTY.clear();
+	ISDIRTY.clear();
+	AMOS.clear();
+	LITAMOS.clear();
+
+	addRootClauses ( atoms, sizes );
+}
 
-	else return true;
+void Formula::countImported ( Clause * clause ) {
+
+	// an imported clause counts once, the first time it takes part in a conflict
+
+	if ( clause -> IMPORTED && ! clause -> USED ) {
+		clause -> USED = true;
+		USEDIMPORTS++;
+	}
 }
 
-// Return unit literal from the unit clause
-Literal* Formula::unitLiteral ( Clause* unit ) {
+int Formula::computeLBD ( Clause * clause ) {
 
-	for ( int i = 0; i < unit -> NumAtom; i++ ) {
+	// number of different levels at which the atoms of the clause were falsified
 
-		int lit_var = unit -> ATOM_LIST[i] -> VAR;
-		int lit_val = unit -> ATOM_LIST[i] -> VAL;
+	vector<int> levels ( clause -> NumAtom );
+	for ( int i = 0; i < clause -> NumAtom; i++ )
+		levels[i] = VARLIST[litVar ( clause -> ATOM_LIST[i] )] -> ATOMLEVEL[litVal ( clause -> ATOM_LIST[i] )];
 
-		if ( VARLIST[lit_var] -> ATOMASSIGN[lit_val] == 0 )
-			return unit -> ATOM_LIST[i];
+	sort ( levels.begin(), levels.end() );
+	return unique ( levels.begin(), levels.end() ) - levels.begin();
+}
+
+void Formula::bumpClause ( Clause * clause ) {
+
+	clause -> ACTIVITY += CLAUSEINC;
+
+	// the same factor for every learned clause keeps their order
+
+	if ( clause -> ACTIVITY > CLAUSERESCALE ) {
+		for ( unsigned int i = ORIGINALCLAUSES; i < CLAUSELIST.size(); i++ )
+			CLAUSELIST[i] -> ACTIVITY /= CLAUSERESCALE;
+		if ( clause -> ACTIVITY > CLAUSERESCALE ) clause -> ACTIVITY /= CLAUSERESCALE; // a new clause is not in CLAUSELIST yet
+		CLAUSEINC /= CLAUSERESCALE;
 	}
+}
 
-	// if no unit literal found, return the default literal -1 ! -1
-	return new Literal ( -1, '!', -1 );
+// CLAUSEWORSE
+// Orders the learned clauses from the least to the most useful one:
+// more levels first, then less activity
+struct CLAUSEWORSE
+{
+  vector<Clause *> & LIST;
+  CLAUSEWORSE ( vector<Clause *> & list ) : LIST ( list ) {}
+  bool operator() ( int a, int b ) const {
+    if ( LIST[a] -> LBD != LIST[b] -> LBD ) return LIST[a] -> LBD > LIST[b] -> LBD;
+    return LIST[a] -> ACTIVITY < LIST[b] -> ACTIVITY;
+  }
+};
+
+void Formula::reduceDB () {
 
+	/*
+	 Delete the least useful half of the learned clauses. The reasons of the assigned
+	 atoms are locked, and clauses over at most two levels (glue clauses) are kept.
+	 The clauses that stay are renumbered in order, so every list of clause numbers
+	 is renumbered too.
+	 */
+
+	int learned = CLAUSELIST.size() - ORIGINALCLAUSES;
+
+	vector<bool> locked;
+	lockLearned ( locked );
+
+	vector<int> candidates;
+	for ( int c = ORIGINALCLAUSES; c < (int) CLAUSELIST.size(); c++ )
+		if ( ! locked[c - ORIGINALCLAUSES] && CLAUSELIST[c] -> LBD > 2 )
+			candidates.push_back ( c );
+
+	sort ( candidates.begin(), candidates.end(), CLAUSEWORSE ( CLAUSELIST ) );
+	candidates.resize ( min ( (int) candidates.size(), learned / 2 ) );
+	deleteLearned ( candidates );
+
+	// the limit grows, and always leaves room for new clauses next to the locked and glue ones
+
+	NEXTREDUCE = max ( NEXTREDUCE, (int) CLAUSELIST.size() - ORIGINALCLAUSES ) + REDUCEINC;
+
+	if ( LOG ) cout << "Deleted " << candidates.size() << " learned clauses, kept " << CLAUSELIST.size() - ORIGINALCLAUSES << endl;
 }
 
+// Mark the learned clauses that are the reasons of assigned atoms
+void Formula::lockLearned ( vector<bool> & locked ) {
 
-// WATCHED LITERALS ALGORITHM functions
+	locked.assign ( CLAUSELIST.size() - ORIGINALCLAUSES, false );
+	for ( unsigned int t = 0; t < TRAIL.size(); t++ ) {
+		int cid = VARLIST[TRAIL[t].var] -> CLAUSEID[TRAIL[t].val];
+		if ( cid >= ORIGINALCLAUSES ) locked[cid - ORIGINALCLAUSES] = true;
+	}
+}
 
-int Formula::watchedCheckSat () {
+// Delete the learned clauses listed, none of them locked, and renumber those that stay
+void Formula::deleteLearned ( const vector<int> & clauses ) {
 
-	// returns 1 if all watched1 is sat (1), otherwise 2 -undefined (2)
+	// new number of each learned clause, -1 if it is deleted
 
-	if (LOG) cout << "Checking satisfiability..." << endl;
+	vector<int> newId ( CLAUSELIST.size() - ORIGINALCLAUSES, 0 );
 
-	for ( unsigned int  i = 0; i < CLAUSELIST.size(); i++ ) {
-		if ( sat ( CLAUSELIST[i] -> WATCHED[0] ) != 1  ) return 2;
+	for ( unsigned int k = 0; k < clauses.size(); k++ ) {
+
+		int c = clauses[k];
+		Clause * clause = CLAUSELIST[c];
+
+		// the literals of an unsatisfied clause are in the counts of unassigned literals
+
+		if ( ! WATCH && ! clause -> SAT ) {
+			UNSATCLAUSES--;
+			for ( int i = 0; i < clause -> NumAtom; i++ ) {
+				LIT atom = clause -> ATOM_LIST[i];
+				if ( VARLIST[litVar ( atom )] -> ATOMASSIGN[litVal ( atom )] == 0 ) {
+					if ( litEqual ( atom ) ) VARLIST[litVar ( atom )] -> ATOMCNTPOS[litVal ( atom )]--;
+					else VARLIST[litVar ( atom )] -> ATOMCNTNEG[litVal ( atom )]--;
+				}
+			}
+		}
+
+		ARENA.release ( clause -> NumAtom );
+		delete clause;
+		CLAUSELIST[c] = NULL;
+		newId[c - ORIGINALCLAUSES] = -1;
+	}
+
+	int kept = ORIGINALCLAUSES;
+	for ( int c = ORIGINALCLAUSES; c < (int) CLAUSELIST.size(); c++ ) {
+		if ( CLAUSELIST[c] != NULL ) {
+			newId[c - ORIGINALCLAUSES] = kept;
+			CLAUSELIST[kept++] = CLAUSELIST[c];
+		}
 	}
+	CLAUSELIST.resize ( kept );
+	DELETEDCLAUSES += clauses.size();
+
+	renumberTheory ( newId );
+
+	// move the learned clauses to a new arena once half of the old one is wasted
 
-	return 1;
+	if ( ARENA.wasted() > ARENA.size() / 2 ) {
+		ClauseArena arena;
+		for ( unsigned int c = ORIGINALCLAUSES; c < CLAUSELIST.size(); c++ ) {
+			LIT * atoms = arena.alloc ( CLAUSELIST[c] -> NumAtom );
+			for ( int i = 0; i < CLAUSELIST[c] -> NumAtom; i++ )
+				atoms[i] = CLAUSELIST[c] -> ATOM_LIST[i];
+			CLAUSELIST[c] -> ATOM_LIST = atoms;
+		}
+		ARENA.swap ( arena );
+	}
 }
 
-int Formula::NewWatchedCheckSat () {
+// Delete the learned clauses that repeat or are subsumed by another learned
+// clause, the locked ones staying
+void Formula::subsumeLearned () {
 
-	// returns 1 if all watched1 is sat (1), 0 if some watched1 and watched2 falsified (0), otherwise 2 -undefined (2)
+	SUBSUMEDAT = LEARNEDCLAUSES;
 
-	if ( LOG ) cout << "Checking satisfiability..." << endl;
+	vector<bool> locked;
+	lockLearned ( locked );
 
-     int counter = 0;
+	Subsumption subsumption ( VARLIST );
+	vector<int> ids;
+	vector<int> deleted;
+	for ( int c = ORIGINALCLAUSES; c < (int) CLAUSELIST.size(); c++ ) {
+		int id = subsumption.add ( CLAUSELIST[c] -> ATOM_LIST, CLAUSELIST[c] -> NumAtom, ! locked[c - ORIGINALCLAUSES] );
+		if ( id < 0 && ! locked[c - ORIGINALCLAUSES] ) deleted.push_back ( c );
+		ids.push_back ( id );
+	}
+	subsumption.simplify ( false );
 
-	for ( unsigned int  i = 0; i < CLAUSELIST.size(); i++ ) {
+	for ( int c = ORIGINALCLAUSES; c < (int) CLAUSELIST.size(); c++ ) {
+		int id = ids[c - ORIGINALCLAUSES];
+		if ( id >= 0 && subsumption.REMOVED[id] ) deleted.push_back ( c );
+	}
+	sort ( deleted.begin(), deleted.end() );
+	if ( ! deleted.empty() ) deleteLearned ( deleted );
 
-		Literal* watched1 = CLAUSELIST[i] -> WATCHED[0];
-		Literal* watched2 = CLAUSELIST[i] -> WATCHED[1];
+	DUPLICATES += subsumption.DUPLICATES;
+	SUBSUMED += subsumption.SUBSUMED;
+	TAUTOLOGIES += subsumption.TAUTOLOGIES;
+	if ( LOG ) cout << "Deleted " << deleted.size() << " subsumed learned clauses, kept " << CLAUSELIST.size() - ORIGINALCLAUSES << endl;
+}
 
-		if ( watched1 -> SAT == 0
-				&& (  watched2  == NULL || watched2 -> SAT == 0 ) ) {
+void Formula::renumberTheory ( const vector<int> & newId ) {
 
-			if (LOG) cout << "Found conflict!" << endl;
+	// renumber the occurrence lists, the watch lists and the reasons
 
-			CONFLICTINGCLAUSE = i;
-			CONFLICT = true;
+	for ( unsigned int i = 1; i < VARLIST.size(); i++ ) {
+		for ( int j = 0; j < VARLIST[i] -> DOMAINSIZE; j++ ) {
+			renumberClauses ( VARLIST[i] -> ATOMRECPOS[j].TAIL, newId );
+			renumberClauses ( VARLIST[i] -> ATOMRECNEG[j].TAIL, newId );
+			if ( WATCH ) {
+				renumberClauses ( VARLIST[i] -> WATCHPOS[j], newId );
+				renumberClauses ( VARLIST[i] -> WATCHNEG[j], newId );
+			}
+		}
+	}
 
-			return 0;
+	for ( unsigned int t = 0; t < TRAIL.size(); t++ ) {
+		int & cid = VARLIST[TRAIL[t].var] -> CLAUSEID[TRAIL[t].val];
+		if ( cid >= ORIGINALCLAUSES ) cid = newId[cid - ORIGINALCLAUSES];
+	}
+
+	DECIDEFROM = renumberCursor ( DECIDEFROM, newId );
+	for ( unsigned int l = 0; l < DECIDEFROMLIM.size(); l++ )
+		DECIDEFROMLIM[l] = renumberCursor ( DECIDEFROMLIM[l], newId );
+}
+
+int Formula::renumberCursor ( int cursor, const vector<int> & newId ) {
+
+	// the clauses deleted before the cursor were skipped, the others keep their order
+
+	int c = cursor;
+	while ( c >= ORIGINALCLAUSES && c - ORIGINALCLAUSES < (int) newId.size() && newId[c - ORIGINALCLAUSES] < 0 ) c++;
+	if ( c < ORIGINALCLAUSES ) return c;
+	if ( c - ORIGINALCLAUSES < (int) newId.size() ) return newId[c - ORIGINALCLAUSES];
+	return CLAUSELIST.size();
+}
+
+void Formula::renumberClauses ( vector<int> & clauses, const vector<int> & newId ) {
 
-		} else if ( watched1 -> SAT != 1 ) counter++;
+	// drop the deleted learned clauses from the list and renumber the others
+
+	int kept = 0;
+	for ( unsigned int k = 0; k < clauses.size(); k++ ) {
+		int cid = clauses[k];
+		if ( cid >= ORIGINALCLAUSES ) cid = newId[cid - ORIGINALCLAUSES];
+		if ( cid >= 0 ) clauses[kept++] = cid;
 	}
+	clauses.resize ( kept );
+}
 
-	if ( counter > 0 ) return 2;
-	else return 1;
+
+bool Formula::falsifies ( LIT literal, LIT decision ) {
+
+	// true if literal falsifies decision
+
+	if ( litVar ( literal ) != litVar ( decision ) ) return false;
+	else if ( litVal ( literal ) != litVal ( decision ) && litEqual ( literal ) != litEqual ( decision ) ) return false;
+	else if ( litVal ( literal ) == litVal ( decision ) && litEqual ( literal ) == litEqual ( decision ) ) return false;
+
+	else return true;
 }
 
+// Return unit literal from the unit clause
+LIT Formula::unitLiteral ( Clause* unit ) {
+
+	for ( int i = 0; i < unit -> NumAtom; i++ ) {
+
+		int lit_var = litVar ( unit -> ATOM_LIST[i] );
+		int lit_val = litVal ( unit -> ATOM_LIST[i] );
+
+		if ( VARLIST[lit_var] -> ATOMASSIGN[lit_val] == 0 )
+			return unit -> ATOM_LIST[i];
+	}
+
+	// if no unit literal found, return the default literal -1 ! -1
+	return NOLIT;
+
+}
+
+
+// WATCHED LITERALS ALGORITHM functions
+
 int Formula::tempwatchedCheckSat () {
 
 	// returns 1 if all watched1 is sat (1), 0 if some watched1 and watched2 falsified (0), otherwise 2 -undefined (2)
@@ -1620,8 +3026,8 @@ int Formula::tempwatchedCheckSat () {
 		int w1 = clause -> W1;
 		int w2 = clause -> W2;
 
-		Literal* watched1 = clause -> ATOM_LIST[w1];
-		Literal* watched2 = NULL;
+		LIT watched1 = clause -> ATOM_LIST[w1];
+		LIT watched2 = NOLIT;
 
 		if ( w2 > -1 ) {
 			watched2 = clause -> ATOM_LIST[w2];
@@ -1633,8 +3039,8 @@ int Formula::tempwatchedCheckSat () {
 
 		clause -> Print(); */
 
-		if (  sat ( watched1 ) == 0 && ! supported ( watched1 -> VAR, clause )
-				&& (  w2 == -1 || ( sat ( watched2 ) == 0 && ! supported ( watched2 -> VAR, clause ) ) ) ) {
+		if (  sat ( watched1 ) == 0 && ! supported ( litVar ( watched1 ), clause )
+				&& (  w2 == -1 || ( sat ( watched2 ) == 0 && ! supported ( litVar ( watched2 ), clause ) ) ) ) {
 
 			if (LOG) cout << "Found conflict!" << endl;
 
@@ -1665,13 +3071,13 @@ int Formula::tempwatchedCheckSat () {
 
 	for ( unsigned int  i = 0; i < CLAUSELIST.size(); i++ ) {
 
-		Literal* watched1 = CLAUSELIST[i] -> ATOM_LIST[CLAUSELIST[i] -> W1];
-		Literal* watched2 = NULL;
+		LIT watched1 = CLAUSELIST[i] -> ATOM_LIST[CLAUSELIST[i] -> W1];
+		LIT watched2 = NOLIT;
 
 		if ( CLAUSELIST[i] -> W2 > -1 ) watched2 = CLAUSELIST[i] -> ATOM_LIST[CLAUSELIST[i] -> W2];
 
 		if ( sat ( watched1 ) == 0
-				&& (  watched2  == NULL || sat ( watched2 ) == 0 ) ) {
+				&& (  watched2  == NOLIT || sat ( watched2 ) == 0 ) ) {
 
 			if (LOG) cout << "Found conflict!" << endl;
 
@@ -1680,9 +3086,9 @@ int Formula::tempwatchedCheckSat () {
 
 			return 0;
 
-		} else if ( sat ( watched1 ) == 2 &&  watched2 == NULL  ) counter++;
+		} else if ( sat ( watched1 ) == 2 &&  watched2 == NOLIT  ) counter++;
 		  else if ( sat ( watched1 ) == 2   ) counter++ ;
-	      else if ( watched2 != NULL && sat ( watched2 ) == 2   ) counter++ ;
+	      else if ( watched2 != NOLIT && sat ( watched2 ) == 2   ) counter++ ;
 	}
 
 	if ( counter > 0 ) return 2;
@@ -1691,16 +3097,16 @@ int Formula::tempwatchedCheckSat () {
 */
 
 
-int Formula::sat ( Literal* literal ) {
+int Formula::sat ( LIT literal ) {
 
 	// computes literal -> SAT
 	// literal -> SAT == 2 unassigned, == 1 satisfied, == 0 falsified
 
-	int var = literal -> VAR;
-	int val = literal -> VAL;
+	int var = litVar ( literal );
+	int val = litVal ( literal );
 	int equals = 0;
 
-	if ( literal -> EQUAL) equals = 1;
+	if ( litEqual ( literal )) equals = 1;
 	else equals = -1;
 
 	if ( VARLIST[var] -> ATOMASSIGN[val] == equals ) return 1; // literal is satisfied
@@ -1709,98 +3115,39 @@ int Formula::sat ( Literal* literal ) {
 
 }
 
-Literal* Formula::tempwatchedCheckUnit () {
+LIT Formula::tempwatchedCheckUnit () {
 
 	//	if ( LOG ) cout << "Checking for units..." << endl;
 
 	for ( unsigned int i = 0; i < CLAUSELIST.size(); i++ ) {
 
-		Literal* watched1 = CLAUSELIST[i] -> ATOM_LIST[CLAUSELIST[i] -> W1];
-		Literal* watched2 = NULL;
+		LIT watched1 = CLAUSELIST[i] -> ATOM_LIST[CLAUSELIST[i] -> W1];
+		LIT watched2 = NOLIT;
 
 		if ( CLAUSELIST[i] -> W2 > -1 ) watched2 = CLAUSELIST[i] -> ATOM_LIST[CLAUSELIST[i] -> W2];
 
 		if ( sat ( watched1 ) == 2 // if watched1 unassigned
-				&& ( watched2 == NULL || ( sat ( watched2 ) == 0 && ! supported( watched2 -> VAR, CLAUSELIST[i]) ) ) ) {
+				&& ( watched2 == NOLIT || ( sat ( watched2 ) == 0 && ! supported( litVar ( watched2 ), CLAUSELIST[i]) ) ) ) {
 			//	cout << "Found unit, watched1" << endl;
 			UNITCLAUSE = i;
 			return watched1;
 		}
 
-		else if ( ( sat ( watched1 ) == 0 && ! supported( watched1 -> VAR, CLAUSELIST[i])) && ( watched2 == NULL || ( sat ( watched2 ) == 0 && ! supported( watched2 -> VAR, CLAUSELIST[i])) ) ) {
+		else if ( ( sat ( watched1 ) == 0 && ! supported( litVar ( watched1 ), CLAUSELIST[i])) && ( watched2 == NOLIT || ( sat ( watched2 ) == 0 && ! supported( litVar ( watched2 ), CLAUSELIST[i])) ) ) {
 					cout << "Found conflict" << endl;
 					CONFLICTINGCLAUSE = i;
 					CONFLICT = true;
-					return NULL;
+					return NOLIT;
 				}
 
-		else if ( ( sat ( watched1 ) == 0 && ! supported( watched1 -> VAR, CLAUSELIST[i])) && sat ( watched2 ) == 2 ) {
+		else if ( ( sat ( watched1 ) == 0 && ! supported( litVar ( watched1 ), CLAUSELIST[i])) && sat ( watched2 ) == 2 ) {
 			//	cout << "Found unit, watched2" << endl;
 			UNITCLAUSE = i;
 			return watched2;
 		}
 	}
 	// if ( LOG ) cout << "No units..." << endl;
-	return NULL;
-}
-
-Literal* Formula::watchedCheckUnit () {
-
-//	if ( LOG ) cout << "Checking for units..." << endl;
-
-	for ( unsigned int i = 0; i < CLAUSELIST.size(); i++ ) {
-
-		Literal* watched1 = CLAUSELIST[i] -> WATCHED[0];
-		Literal* watched2 = CLAUSELIST[i] -> WATCHED[1];
-
-		if ( watched1 == NULL ) { ;
-		}
-		if ( sat ( watched1 ) == 2 // if watched1 unassigned
-				&& ( watched2 == NULL || sat ( watched2 ) == 0 ) ) {
-		//	cout << "Found unit, watched1" << endl;
-			UNITCLAUSE = i;
-			return watched1;
-		}
-
-	/*	else if ( sat ( watched1 ) == 0 && ( watched2 == NULL || sat ( watched2 ) == 0 ) ) {
-					cout << "Found conflict" << endl;
-					CONFLICTINGCLAUSE = i;
-					CONFLICT = true;
-					return NULL;
-				} */
-
-		else if ( sat ( watched1 ) == 0 && sat ( watched2 ) == 2 ) {
-		//	cout << "Found unit, watched2" << endl;
-			UNITCLAUSE = i;
-			return watched2;
-		}
-	}
-	// if ( LOG ) cout << "No units..." << endl;
-	return NULL;
-}
-
-void Formula::NewWatchedCheckUnit () {
-
-//	if ( LOG ) cout << "Checking for units..." << endl;
-	UNITLIST.clear();
-	for ( unsigned int i = 0; i < CLAUSELIST.size(); i++ ) {
-
-		Literal* watched1 = CLAUSELIST[i] -> WATCHED[0];
-		Literal* watched2 = CLAUSELIST[i] -> WATCHED[1];
-		int sat_wl1 = sat(watched1);
-
-		if ( sat_wl1 == 2 // if watched1 unassigned
-				&& ( watched2 == NULL || sat ( watched2 ) == 0 ) ) {
-		//	cout << "Found unit, watched1" << endl;
-			UNITLIST.push_back(i);
-		}
-
-		else if ( sat_wl1 == 0 && sat ( watched2 ) == 2 ) {
-		//	cout << "Found unit, watched2" << endl;
-		UNITLIST.push_back(i);
-		}
-	}
-	// if ( LOG ) cout << "No units..." << endl;
+	return NOLIT;
 }
 
 
@@ -1819,22 +3166,32 @@ void Formula::WatchedUnitPropagation()
 
 		Clause* clause = CLAUSELIST[unit_clause];
 
-		if ( sat ( clause -> WATCHED[0] ) == 2 ) {
-			watchedReduceTheory(clause -> WATCHED[0], clause -> WATCHED[0] -> VAR, clause -> WATCHED[0] -> EQUAL, clause -> WATCHED[0] -> VAL);
-			UNITS++;
+		// the clause is unit if one watched literal is unassigned and the other one falsified
+
+		LIT watched1 = clause -> WATCHED[0];
+		LIT watched2 = clause -> WATCHED[1];
+		int sat1 = sat ( watched1 );
+		int sat2 = ( watched2 == NOLIT ? 0 : sat ( watched2 ) );
+		LIT unit = NOLIT;
+
+		if ( sat1 == 2 && sat2 == 0 ) unit = watched1;
+		else if ( sat2 == 2 && sat1 == 0 ) unit = watched2;
+		else if ( sat1 == 0 && sat2 == 0 ) {
+			CONFLICT = true;
+			CONFLICTINGCLAUSE = unit_clause;
 		}
-		else if ( sat ( clause -> WATCHED[1] ) == 2 ) {
-			watchedReduceTheory(clause -> WATCHED[1], clause -> WATCHED[1] -> VAR, clause -> WATCHED[1] -> EQUAL, clause -> WATCHED[1] -> VAL);
-			UNITS++;
-	}
 
+		if ( unit ) {
+			watchedReduceTheory ( unit, litVar ( unit ), litEqual ( unit ), litVal ( unit ) );
+			UNITS++;
+		}
 	}
 
 	if ( CONFLICT ) UNITLIST.clear();
 
 }
 
-Literal* Formula::watchedChooseLiteral () {
+LIT Formula::watchedChooseLiteral () {
 
 	/*  Pick a literal which is not yet satisfied, and which satisfies more clauses and removes less literals,
 	 *  use literal counts. Many other heuristics are possible.
@@ -1862,165 +3219,174 @@ Literal* Formula::watchedChooseLiteral () {
 			}
 		}
 	}
-	return ( tvar != -1 ? new Literal ( tvar, tval ) : lazyWatchedChooseLiteral () );
+	return ( tvar != -1 ? makeLit ( tvar, true, tval ) : lazyWatchedChooseLiteral () );
 }
 
 
-Literal * Formula::lazyWatchedChooseLiteral () {
-
-	// Choose any unassigned first watched literal
+LIT Formula::lazyWatchedChooseLiteral () {
 
+	// Choose the first unassigned first watched literal. After the propagation a clause
+	// skipped has a true watch, which is never moved, so it is skipped again until the
+	// level is undone: the scan goes on from DECIDEFROM, watchedUndoTheory moves it back
 
-	for ( unsigned int  i = 0; i < CLAUSELIST.size(); i++ ) {
+	for ( ; DECIDEFROM < (int) CLAUSELIST.size(); DECIDEFROM++ ) {
 
-		Literal* watched1 = CLAUSELIST[i] -> WATCHED[0];
+		LIT watched1 = CLAUSELIST[DECIDEFROM] -> WATCHED[0];
+		LIT watched2 = CLAUSELIST[DECIDEFROM] -> WATCHED[1];
 
-		if ( sat ( watched1 ) == 2) return  watched1;
+		// skip clauses already satisfied through watched2
+		if ( sat ( watched1 ) == 2 && ( watched2 == NOLIT || sat ( watched2 ) != 1 ) ) return  watched1;
 	}
-	return NULL;
+	return NOLIT;
 }
 
 
 
-Literal* Formula::lazyChooseLiteral() {
+LIT Formula::decideAssumption () {
 
-	for ( unsigned int  i = 0; i < CLAUSELIST.size(); i++ ) {
+	// the assumptions take the first levels in order; one that already holds keeps
+	// its level empty, so the assumption of a level is always at the same index
 
-		Clause* clause = CLAUSELIST[i];
-
-		for ( int j = 0 ; ! clause -> SAT && j < clause -> ATOM_LIST.size(); j++ ) {
+	while ( LEVEL < (int) ASSUMPTIONS.size() ) {
 
-			Literal* literal = clause -> ATOM_LIST[j];
-
-			if ( sat ( literal ) == 2 ) return literal;
+		LIT atom = ASSUMPTIONS[LEVEL];
+		int value = sat ( atom );
 
+		if ( value == 2 ) return atom;
+		if ( value == 0 ) {
+			FAILEDASSUMPTION = true;
+			return NOLIT;
 		}
+		LEVEL++;
 	}
-
-	return NULL;
-
-
+	return NOLIT;
 }
 
+int Formula::checkLimits () {
 
-Literal * Formula::templazyWatchedChooseLiteral () {
-
-	// Choose any unassigned first watched literal
-
-	for ( unsigned int  i = 0; i < CLAUSELIST.size(); i++ ) {
+	// a stop asked by another thread is seen at once, the clock and the memory are
+	// read once every LIMITPERIOD steps, a step being a propagation or a decision
 
-		Literal* watched1 = CLAUSELIST[i] -> ATOM_LIST[CLAUSELIST[i] -> W1];
+	if ( stopped() ) return 1;
+	if ( ++LIMITCOUNT < LIMITPERIOD ) return 0;
+	LIMITCOUNT = 0;
 
-		if ( sat ( watched1 ) == 2) return  watched1;
-	}
-	return NULL;
+	TIME_E = GetTime();
+	if ( ( TIME_E - TIME_S ) > TIMELIMIT ) return 1;
+	if ( MEMLIMIT > 0 && memoryUsed() > ( (long) MEMLIMIT << 20 ) ) return MEMOUT;
+	return 0;
 }
 
+long Formula::memoryUsed () const {
 
-void Formula::SwapPointer ( Clause* clause ) {
-
-	Literal* watched1 = clause -> WATCHED[0];
-	Literal* watched2 = clause -> WATCHED[1];
+	// what the clauses in use take: each literal is stored once in an arena and has an
+	// occurrence, each clause has its object, its entry in CLAUSELIST and, for the
+	// watched engines, its two watches. Deleted clauses and the room of the arena
+	// blocks not handed out yet are not counted; the rest of the formula is small
 
+	long literals = INPUTARENA.size() - INPUTARENA.wasted() + ARENA.size() - ARENA.wasted();
+	long clause = sizeof ( Clause ) + sizeof ( Clause * ) + ( WATCH || CMV ? 2 * sizeof ( int ) : 0 );
+	return literals * (long) ( sizeof ( LIT ) + sizeof ( int ) ) + (long) CLAUSELIST.size() * clause;
+}
 
-	if ( watched2 != NULL && sat ( watched2 )  == 2 ) {
+void Formula::resetSearch () {
 
-		// if watched2 unassigned, watched1 falsified
+	// back to the level 0 so the engine can run again, e.g. under other assumptions
 
-		for ( int i = 0; i < clause -> NumAtom; i++ ) {
+	if ( WATCH || CMV ) watchedUndoTheory ( 0 );
+	else undoTheory ( 0 );
+	LEVEL = 0;
+	CONFLICT = false;
+	UNITLIST.clear();
+}
 
-			Literal* literal = clause -> ATOM_LIST[i];
+int Formula::probe ( LIT atom ) {
 
-			if (  VARLIST[literal -> VAR] -> ATOMASSIGN[literal -> VAL] == 0 && ! LitIsEqual ( literal, watched2 ) ) {
+	// lookahead of the counting engine: the consequences of the atom are measured
+	// by the clauses they satisfy, the counters of the search are left alone
 
+	int unsat = UNSATCLAUSES;
+	int units = UNITS;
+	int entails = ENTAILS;
 
-				clause -> WATCHED[0] = literal;
+	LEVEL++;
+	UNITCLAUSE = -1;
+	UNITLIST.clear();
+	reduceTheory ( litVar ( atom ), litEqual ( atom ), litVal ( atom ) );
+	if ( ! CONFLICT ) unitPropagation();
+	int reduced = ( CONFLICT ? -1 : unsat - UNSATCLAUSES );
 
-				VARLIST[literal -> VAR] -> ATOMWATCH[literal -> VAL] = 1;
-				break;
-			}
-		}
-	} else if ( watched2 != NULL && sat ( watched1 )  == 2  ) {
+	CONFLICT = false;
+	UNITLIST.clear();
+	LEVEL--;
+	undoTheory ( LEVEL );
+	UNITS = units;
+	ENTAILS = entails;
+	return reduced;
+}
 
-	//	cout << "watched1 unassigned" << endl;
+LIT Formula::savedPhase ( LIT atom ) {
 
-		for ( int i; i < clause -> NumAtom; i++ ) {
+	// a variable branched on again gets the value it held last, if that value is still
+	// possible. This covers both var=val and var!=val decisions, the heuristic chooses
+	// the variable and the saved value replaces the literal
 
-			Literal* literal = clause -> ATOM_LIST[i];
+	if ( ! PHASE || atom == NOLIT ) return atom;
 
-			if ( sat ( literal ) == 2 && ! LitIsEqual ( literal, watched1 ) ) {
-				clause -> WATCHED[1] = literal;
-				VARLIST[literal -> VAR] -> ATOMWATCH[literal -> VAL] = 2;
-			}
-		}
-	} else {
-		CONFLICT = true;
-	}
+	Variable * variable = VARLIST[litVar ( atom )];
+
+	if ( variable -> SAVED >= 0 && variable -> ATOMASSIGN[variable -> SAVED] == 0 )
+		return makeLit ( litVar ( atom ), true, variable -> SAVED );
+
+	return atom;
 }
 
-void Formula::SwapPointer ( int clause_num ) {
+LIT Formula::lazyChooseLiteral() {
 
-    Clause* clause = CLAUSELIST[clause_num];
+	for ( unsigned int  i = 0; i < CLAUSELIST.size(); i++ ) {
 
-	Literal* watched1 = clause -> WATCHED[0];
-	Literal* watched2 = clause -> WATCHED[1];
+		Clause* clause = CLAUSELIST[i];
 
-	bool unitClause = true;
+		for ( int j = 0 ; ! clause -> SAT && j < clause -> NumAtom; j++ ) {
 
-	if ( watched2 != NULL && sat ( watched2 )  == 2 ) {
+			LIT literal = clause -> ATOM_LIST[j];
 
-		// if watched2 unassigned, watched1 falsified
+			if ( sat ( literal ) == 2 ) return literal;
 
-		for ( int i = 0; i < clause -> NumAtom; i++ ) {
+		}
+	}
 
-			Literal* literal = clause -> ATOM_LIST[i];
+	return NOLIT;
 
-			if (  VARLIST[literal -> VAR] -> ATOMASSIGN[literal -> VAL] == 0 && ! LitIsEqual ( literal, watched2 ) ) {
 
+}
 
-				clause -> WATCHED[0] = literal;
 
-				VARLIST[literal -> VAR] -> ATOMWATCH[literal -> VAL] = 1;
-				unitClause = false;
-				break;
-			}
-		}
-	} else if ( watched2 != NULL && sat ( watched1 )  == 2  ) {
+LIT Formula::templazyWatchedChooseLiteral () {
 
-		for ( int i = 0; i < clause -> NumAtom; i++ ) {
+	// Choose any unassigned first watched literal
 
-			Literal* literal = clause -> ATOM_LIST[i];
+	for ( unsigned int  i = 0; i < CLAUSELIST.size(); i++ ) {
 
-			if ( VARLIST[literal -> VAR] -> ATOMASSIGN[literal -> VAL] == 0 && ! LitIsEqual ( literal, watched1 ) ) {
-				clause -> WATCHED[1] = literal;
-				VARLIST[literal -> VAR] -> ATOMWATCH[literal -> VAL] = 2;
-				unitClause = false;
-				break;
+		LIT watched1 = CLAUSELIST[i] -> ATOM_LIST[CLAUSELIST[i] -> W1];
 
-			}
-		}
-	} else {
-		if ( LOG ) cout << "Conflict" << endl;
-		CONFLICT = true;
-		CONFLICTINGCLAUSE = clause_num;
-		unitClause = false;
-	}
-	if (unitClause) {
-		UNITLIST.push_front(clause_num);
+		if ( sat ( watched1 ) == 2) return  watched1;
 	}
+	return NOLIT;
 }
 
 
+
 void Formula::tempSwapPointer ( int clause_num ) {
 
 	Clause* clause = CLAUSELIST[clause_num];
 
-	Literal* watched1 = clause -> ATOM_LIST[clause -> W1];
-	Literal* watched2 = clause -> ATOM_LIST[clause -> W2];
+	LIT watched1 = clause -> ATOM_LIST[clause -> W1];
+	LIT watched2 = clause -> ATOM_LIST[clause -> W2];
 
 	bool flag = false;
 
-	if ( watched2 != NULL && sat ( watched2 )  == 2 ) {
+	if ( watched2 != NOLIT && sat ( watched2 )  == 2 ) {
 
 		// if watched2 unassigned, watched1 falsified
 
@@ -2028,20 +3394,20 @@ void Formula::tempSwapPointer ( int clause_num ) {
 
 		for ( int i = clause -> W1 + 1; i < clause -> NumAtom; i++ ) {
 
-			Literal* literal = clause -> ATOM_LIST[i];
+			LIT literal = clause -> ATOM_LIST[i];
 
-			if (  VARLIST[literal -> VAR] -> ATOMASSIGN[literal -> VAL] == 0 && ! LitIsEqual ( literal, watched2 ) ) {
+			if (  VARLIST[litVar ( literal )] -> ATOMASSIGN[litVal ( literal )] == 0 && ! LitIsEqual ( literal, watched2 ) ) {
 
 				clause -> W1 = i;
 
-				VARLIST[literal -> VAR] -> ATOMWATCH[literal -> VAL] = 1;
+				VARLIST[litVar ( literal )] -> ATOMWATCH[litVal ( literal )] = 1;
 
-				if ( literal -> VAR != watched2 -> VAR ) {
+				if ( litVar ( literal ) != litVar ( watched2 ) ) {
 
 					clause -> W1 = i;
 				}
 
-				if ( literal -> VAR == watched1 -> VAR ) {
+				if ( litVar ( literal ) == litVar ( watched1 ) ) {
 
 					flag = true;
 					break;
@@ -2053,21 +3419,21 @@ void Formula::tempSwapPointer ( int clause_num ) {
 
 			for ( int i =  0 ; i < clause -> W1 + 1; i++ ) {
 
-				Literal* literal = clause -> ATOM_LIST[i];
+				LIT literal = clause -> ATOM_LIST[i];
 
-				if (  VARLIST[literal -> VAR] -> ATOMASSIGN[literal -> VAL] == 0 && ! LitIsEqual ( literal, watched2 ) ) {
+				if (  VARLIST[litVar ( literal )] -> ATOMASSIGN[litVal ( literal )] == 0 && ! LitIsEqual ( literal, watched2 ) ) {
 
 
-					if ( literal -> VAR != watched2 -> VAR ) {
+					if ( litVar ( literal ) != litVar ( watched2 ) ) {
 
 						clause -> W1 = i;
 					}
 
 					clause -> W1 = i;
 
-					VARLIST[literal -> VAR] -> ATOMWATCH[literal -> VAL] = 1;
+					VARLIST[litVar ( literal )] -> ATOMWATCH[litVal ( literal )] = 1;
 
-					if ( literal -> VAR == watched1 -> VAR ) {
+					if ( litVar ( literal ) == litVar ( watched1 ) ) {
 
 						flag = true;
 						break;
@@ -2077,24 +3443,24 @@ void Formula::tempSwapPointer ( int clause_num ) {
 			}
 		}
 
-	} else if ( watched2 != NULL && sat ( watched1 )  == 2  ) {
+	} else if ( watched2 != NOLIT && sat ( watched1 )  == 2  ) {
 
 		for ( int i = clause -> W2 + 1; i < clause -> NumAtom; i++ ) {
 
-			Literal* literal = clause -> ATOM_LIST[i];
+			LIT literal = clause -> ATOM_LIST[i];
 
 			if ( sat ( literal ) == 2 && ! LitIsEqual ( literal, watched1 ) ) {
 
-				if ( literal -> VAR != watched1 -> VAR ) {
+				if ( litVar ( literal ) != litVar ( watched1 ) ) {
 
 					clause -> W2 = i;
 				}
 
 				clause -> W2 = i;
 
-				VARLIST[literal -> VAR] -> ATOMWATCH[literal -> VAL] = 2;
+				VARLIST[litVar ( literal )] -> ATOMWATCH[litVal ( literal )] = 2;
 
-				if ( literal -> VAR == watched2 -> VAR ) {
+				if ( litVar ( literal ) == litVar ( watched2 ) ) {
 
 					flag = true;
 					break;
@@ -2107,26 +3473,26 @@ void Formula::tempSwapPointer ( int clause_num ) {
 
 			for ( int i = 0; i < clause -> W2 + 1; i++ ) {
 
-				Literal* literal = clause -> ATOM_LIST[i];
+				LIT literal = clause -> ATOM_LIST[i];
 
 				if ( sat ( literal ) == 2 && ! LitIsEqual ( literal, watched1 ) ) {
 
-					if ( literal -> VAR != watched1 -> VAR ) {
+					if ( litVar ( literal ) != litVar ( watched1 ) ) {
 
 						clause -> W2 = i;
 					}
 
 
 					clause -> W2 = i;
-					VARLIST[literal -> VAR] -> ATOMWATCH[literal -> VAL] = 2;
+					VARLIST[litVar ( literal )] -> ATOMWATCH[litVal ( literal )] = 2;
 
-					if ( literal -> VAR == watched2 -> VAR ) {
+					if ( litVar ( literal ) == litVar ( watched2 ) ) {
 
 						flag = true;
 						break;
 					}
 
-					if ( literal -> VAR != watched1 -> VAR ) {
+					if ( litVar ( literal ) != litVar ( watched1 ) ) {
 						clause -> W2 = i;
 					}
 				}
@@ -2141,12 +3507,12 @@ void Formula::tempSwapPointer ( int clause_num ) {
 
 	Clause* clause = CLAUSELIST[clause_num];
 
-	Literal* watched1 = clause -> ATOM_LIST[clause -> W1];
-	Literal* watched2 = clause -> ATOM_LIST[clause -> W2];
+	LIT watched1 = clause -> ATOM_LIST[clause -> W1];
+	LIT watched2 = clause -> ATOM_LIST[clause -> W2];
 
 	bool flag = false;
 
-	if ( watched2 != NULL && sat ( watched2 )  == 2 ) {
+	if ( watched2 != NOLIT && sat ( watched2 )  == 2 ) {
 
 		// if watched2 unassigned, watched1 falsified
 
@@ -2154,15 +3520,15 @@ void Formula::tempSwapPointer ( int clause_num ) {
 
 		for ( int i = clause -> W1 + 1; i < clause -> NumAtom; i++ ) {
 
-			Literal* literal = clause -> ATOM_LIST[i];
+			LIT literal = clause -> ATOM_LIST[i];
 
-			if (  VARLIST[literal -> VAR] -> ATOMASSIGN[literal -> VAL] == 0 && ! LitIsEqual ( literal, watched2 ) ) {
+			if (  VARLIST[litVar ( literal )] -> ATOMASSIGN[litVal ( literal )] == 0 && ! LitIsEqual ( literal, watched2 ) ) {
 
 				clause -> W1 = i;
 
-				VARLIST[literal -> VAR] -> ATOMWATCH[literal -> VAL] = 1;
+				VARLIST[litVar ( literal )] -> ATOMWATCH[litVal ( literal )] = 1;
 
-				if ( literal -> VAR != watched2 -> VAR ) {
+				if ( litVar ( literal ) != litVar ( watched2 ) ) {
 
 					clause -> W1 = i;
 				}
@@ -2170,7 +3536,7 @@ void Formula::tempSwapPointer ( int clause_num ) {
 
 
 
-				if ( literal -> VAR == watched1 -> VAR ) {
+				if ( litVar ( literal ) == litVar ( watched1 ) ) {
 
 					flag = true;
 					break;
@@ -2182,21 +3548,21 @@ void Formula::tempSwapPointer ( int clause_num ) {
 
 			for ( int i =  0 ; i < clause -> W1 + 1; i++ ) {
 
-				Literal* literal = clause -> ATOM_LIST[i];
+				LIT literal = clause -> ATOM_LIST[i];
 
-				if (  VARLIST[literal -> VAR] -> ATOMASSIGN[literal -> VAL] == 0 && ! LitIsEqual ( literal, watched2 ) ) {
+				if (  VARLIST[litVar ( literal )] -> ATOMASSIGN[litVal ( literal )] == 0 && ! LitIsEqual ( literal, watched2 ) ) {
 
 
-					if ( literal -> VAR != watched2 -> VAR ) {
+					if ( litVar ( literal ) != litVar ( watched2 ) ) {
 
 						clause -> W1 = i;
 					}
 
 					clause -> W1 = i;
 
-					VARLIST[literal -> VAR] -> ATOMWATCH[literal -> VAL] = 1;
+					VARLIST[litVar ( literal )] -> ATOMWATCH[litVal ( literal )] = 1;
 
-					if ( literal -> VAR == watched1 -> VAR ) {
+					if ( litVar ( literal ) == litVar ( watched1 ) ) {
 
 						flag = true;
 						break;
@@ -2206,24 +3572,24 @@ void Formula::tempSwapPointer ( int clause_num ) {
 			}
 		}
 
-	} else if ( watched2 != NULL && sat ( watched1 )  == 2  ) {
+	} else if ( watched2 != NOLIT && sat ( watched1 )  == 2  ) {
 
 		for ( int i = clause -> W2 + 1; i < clause -> NumAtom; i++ ) {
 
-			Literal* literal = clause -> ATOM_LIST[i];
+			LIT literal = clause -> ATOM_LIST[i];
 
 			if ( sat ( literal ) == 2 && ! LitIsEqual ( literal, watched1 ) ) {
 
-				if ( literal -> VAR != watched1 -> VAR ) {
+				if ( litVar ( literal ) != litVar ( watched1 ) ) {
 
 					clause -> W2 = i;
 				}
 
 				clause -> W2 = i;
 
-				VARLIST[literal -> VAR] -> ATOMWATCH[literal -> VAL] = 2;
+				VARLIST[litVar ( literal )] -> ATOMWATCH[litVal ( literal )] = 2;
 
-				if ( literal -> VAR == watched2 -> VAR ) {
+				if ( litVar ( literal ) == litVar ( watched2 ) ) {
 
 					flag = true;
 					break;
@@ -2236,26 +3602,26 @@ void Formula::tempSwapPointer ( int clause_num ) {
 
 			for ( int i = 0; i < clause -> W2 + 1; i++ ) {
 
-				Literal* literal = clause -> ATOM_LIST[i];
+				LIT literal = clause -> ATOM_LIST[i];
 
 				if ( sat ( literal ) == 2 && ! LitIsEqual ( literal, watched1 ) ) {
 
-					if ( literal -> VAR != watched1 -> VAR ) {
+					if ( litVar ( literal ) != litVar ( watched1 ) ) {
 
 						clause -> W2 = i;
 					}
 
 
 					clause -> W2 = i;
-					VARLIST[literal -> VAR] -> ATOMWATCH[literal -> VAL] = 2;
+					VARLIST[litVar ( literal )] -> ATOMWATCH[litVal ( literal )] = 2;
 
-					if ( literal -> VAR == watched2 -> VAR ) {
+					if ( litVar ( literal ) == litVar ( watched2 ) ) {
 
 						flag = true;
 						break;
 					}
 
-					if ( literal -> VAR != watched1 -> VAR ) {
+					if ( litVar ( literal ) != litVar ( watched1 ) ) {
 						clause -> W2 = i;
 					}
 				}
@@ -2265,28 +3631,26 @@ void Formula::tempSwapPointer ( int clause_num ) {
 } */
 
 
-bool Formula::LitIsEqual ( Literal* literal1, Literal * literal2 ) {
+bool Formula::LitIsEqual ( LIT literal1, LIT literal2 ) {
 
-	if ( literal1 -> VAR == literal2 -> VAR && literal1 -> VAL == literal2 -> VAL
-			&& literal1 -> EQUAL == literal2 -> EQUAL ) return true;
-
-	else return false;
+	return literal1 == literal2;
 }
 
-void Formula::watchedReduceTheory ( Literal * literal, int var, bool equals, int val ) {
+void Formula::watchedReduceTheory ( LIT literal, int var, bool equals, int val ) {
 
 	if ( equals ) {
 
 		if ( LOG ) cout << var << "=" << val << " at level " << LEVEL << endl;
 
 		VARLIST[var] -> ATOMASSIGN[val] = 1;
+		pushTrail ( var, val );
 		VARLIST[var] -> ATOMLEVEL[val] = LEVEL;
 		VARLIST[var] -> VAL = val;
 		VARLIST[var] -> SAT = true; // means variable is assigned. REDUNDANT!
 		VARLIST[var] -> LEVEL = LEVEL; // value assigned a positive value at this level
 		VARLIST[var] -> CLAUSEID[val] = UNITCLAUSE; 		// Set the reason for the literal
 		DECSTACK.push_back(literal); 		// Add literal to the decision stack
-		VARLIST[var] -> ATOMINDEX[val] = DECSTACK.size() - 1; // to use in maxLit
+		VARLIST[var] -> ATOMINDEX[val] = DECSTACK.size() - 1; // to use in analyzeConflict
 
 		// COUNTER = # of falsified values
 		VARLIST[var] -> COUNTER = VARLIST[var] -> DOMAINSIZE -1; // all other values are falsified: no real need for counter here ! (?)
@@ -2303,8 +3667,7 @@ void Formula::watchedReduceTheory ( Literal * literal, int var, bool equals, int
 			tempwatchedFalsifyLiteral ( var, ! equals, val ); // if one of the watched literals falsified, swap watched literals
 		} else {
 
-			watchedSatisfyLiteral ( var, equals, val ); // set the literal to watched1 - then checkSat == 1
-			watchedFalsifyLiteral ( var, ! equals, val ); // if one of the watched literals falsified, swap watched literals
+			watchedFalsifyLiteral ( var, ! equals, val ); // visit the clauses watching the falsified literal
 		}
 
 		//for each different domain value x from dom(var) which is not assigned (0) assign it
@@ -2314,11 +3677,12 @@ void Formula::watchedReduceTheory ( Literal * literal, int var, bool equals, int
 			if ( VARLIST[var] -> ATOMASSIGN[i] == 0 ) {
 
 				VARLIST[var]->ATOMASSIGN[i] = -1;
+				pushTrail ( var, i );
 				VARLIST[var]->ATOMLEVEL[i] = LEVEL;
 
 				// Set the same reason:
 				VARLIST[var]->CLAUSEID[i] = UNITCLAUSE;
-				VARLIST[var] -> ATOMINDEX[i] = DECSTACK.size() - 1; // to use in maxLit
+				VARLIST[var] -> ATOMINDEX[i] = DECSTACK.size() - 1; // to use in analyzeConflict
 
 
 				if ( CMV ) {
@@ -2327,8 +3691,7 @@ void Formula::watchedReduceTheory ( Literal * literal, int var, bool equals, int
 					tempwatchedFalsifyLiteral ( var, equals, i ); // if one of the watched literals falsified, swap watched literals
 				} else {
 
-					watchedSatisfyLiteral ( var, !equals, i ); // set the literal to watched1 - then checkSat == 1
-					watchedFalsifyLiteral ( var, equals, i ); // if one of the watched literals falsified, swap watched literals
+					watchedFalsifyLiteral ( var, equals, i ); // visit the clauses watching the falsified literal
 				}
 
 
@@ -2340,10 +3703,11 @@ void Formula::watchedReduceTheory ( Literal * literal, int var, bool equals, int
 			if ( VARLIST[var] -> ATOMASSIGN[i] == 0 ) {
 
 				VARLIST[var]->ATOMASSIGN[i] = -1;
+				pushTrail ( var, i );
 				VARLIST[var]->ATOMLEVEL[i] = LEVEL;
 
 				VARLIST[var] -> CLAUSEID[i] = UNITCLAUSE;
-				VARLIST[var] -> ATOMINDEX[i] = DECSTACK.size() - 1; // to use in maxLit
+				VARLIST[var] -> ATOMINDEX[i] = DECSTACK.size() - 1; // to use in analyzeConflict
 
 				if ( CMV ) {
 
@@ -2351,8 +3715,7 @@ void Formula::watchedReduceTheory ( Literal * literal, int var, bool equals, int
 					tempwatchedFalsifyLiteral ( var, equals, i ); // if one of the watched literals falsified, swap watched literals
 				} else {
 
-					watchedSatisfyLiteral ( var, !equals, i ); // set the literal to watched1 - then checkSat == 1
-					watchedFalsifyLiteral ( var, equals, i ); // if one of the watched literals falsified, swap watched literals
+					watchedFalsifyLiteral ( var, equals, i ); // visit the clauses watching the falsified literal
 				}
 			}
 		}
@@ -2361,12 +3724,13 @@ void Formula::watchedReduceTheory ( Literal * literal, int var, bool equals, int
 		if ( LOG ) cout << var << "!" << val << " at level " << LEVEL << endl;
 
 		VARLIST[var] -> ATOMASSIGN[val] = -1;
+		pushTrail ( var, val );
 		VARLIST[var] -> ATOMLEVEL[val] = LEVEL;
 		// Set the reason:
 		VARLIST[var] -> CLAUSEID[val] = UNITCLAUSE;
 		//Add literal to decision stack:
 		DECSTACK.push_back ( literal );
-		VARLIST[var] -> ATOMINDEX[val] = DECSTACK.size() - 1; // to use in maxLit
+		VARLIST[var] -> ATOMINDEX[val] = DECSTACK.size() - 1; // to use in analyzeConflict
 
 		// one more value falsified
 		VARLIST[var] -> COUNTER++;
@@ -2376,18 +3740,17 @@ void Formula::watchedReduceTheory ( Literal * literal, int var, bool equals, int
 			tempwatchedFalsifyLiteral ( var, ! equals, val );
 		} else {
 
-			watchedSatisfyLiteral ( var, equals, val );
 			watchedFalsifyLiteral ( var, ! equals, val );
 		}
 
 
 		//check Entailment on this variable
 		if ( checkEntail ( var ) ) {
-			if ( LOG ) cout << "Entailment... " << ENTAILLITERAL -> VAR << "=" << ENTAILLITERAL -> VAL << endl;
+			if ( LOG ) cout << "Entailment... " << litVar ( ENTAILLITERAL ) << "=" << litVal ( ENTAILLITERAL ) << endl;
 			ENTAILS++;
 			// Set the reason:
 			UNITCLAUSE = -2;
-			watchedReduceTheory ( ENTAILLITERAL, ENTAILLITERAL -> VAR, true, ENTAILLITERAL -> VAL );
+			watchedReduceTheory ( ENTAILLITERAL, litVar ( ENTAILLITERAL ), true, litVal ( ENTAILLITERAL ) );
 		}
 
 	}
@@ -2395,43 +3758,45 @@ void Formula::watchedReduceTheory ( Literal * literal, int var, bool equals, int
 }
 //=================== Watched literals NON-CHRONOLOGICAL BACKTRACK ============================//
 
-int Formula::NewWatchedLiterals ( int restarts ) {
-
-
-	int restartCount = restarts;
+int Formula::WatchedLiterals () {
 
 	// returns 0 if sat, 1 if timeout, 2 if unsat
 
 	if ( LOG ) cout << "Solving with the watched literal algorithm..." << endl;
 
-	while ( true ) {
-		//Check if the theory satisfied
+	// clauses with a single literal are units from the start, the rest is found through the watch lists
 
+	for ( unsigned int i = 0; i < CLAUSELIST.size(); i++ )
+		if ( CLAUSELIST[i] -> NumAtom == 1 ) UNITLIST.push_back ( i );
+	FAILEDASSUMPTION = false;
 
-		if ( watchedCheckSat() == 1 )
-			return 0; //
+	while ( true ) {
 
-		//Check if time out
-		TIME_E = GetTime();
-	//	if ( ( TIME_E - TIME_S ) > TIMELIMIT )
-		//	return 1;
+		//Check if time out or out of memory
+		int limit = checkLimits();
+		if ( limit ) return limit;
 
 		if ( CONFLICT ) {
 
 			if ( LOG ) {
 				cout << "There is a conflict at level: " << LEVEL << endl;
 				cout<<"Conflicting clause: "<<  endl;
-				CLAUSELIST[CONFLICTINGCLAUSE] -> Print ();
+				if ( CONFLICTINGCLAUSE > AMOREASON ) CLAUSELIST[CONFLICTINGCLAUSE] -> Print ();
+				else cout << "at most one constraint " << AMOREASON - CONFLICTINGCLAUSE << endl;
 			}
 
 
-			if ( LEVEL == 0 ) { cout << "UNSAT" << endl; return 2; }
+			if ( LEVEL == 0 ) { if ( LOG ) cout << "UNSAT" << endl; return 2; }
 
-			Clause* learned = analyzeConflict ( CLAUSELIST[CONFLICTINGCLAUSE] );
+			Clause* learned = analyzeConflict ( CONFLICTINGCLAUSE );
+			if ( learned -> NumAtom == 0 ) { delete learned; if ( LOG ) cout << "UNSAT" << endl; return 2; }
+			int learnedId = CLAUSELIST.size() - 1;
 			LEVEL = backtrackLevel ( learned );
 
-			if ( learned -> NumAtom > 1) {
-			learned -> WATCHED[1] = learned -> ATOM_LIST[WATCHED2];
+			if ( learned -> NumAtom > 1 ) {
+				// never watch the same literal twice
+				if ( WATCHED2 == LASTFALSE ) WATCHED2 = ( LASTFALSE == 0 ? 1 : 0 );
+				learned -> WATCHED[1] = learned -> ATOM_LIST[WATCHED2];
 			}
 
 			BACKTRACKS++;
@@ -2440,142 +3805,79 @@ int Formula::NewWatchedLiterals ( int restarts ) {
 				cout << "# of backtracks so far: " << BACKTRACKS << endl;
 			}
 			CONFLICT = false;
+			UNITLIST.clear();
 
-			if ( BACKTRACKS == restartCount ) {
-
+			RESTARTER.conflict ( learned -> LBD );
 
-				//	cout << "restarting" << endl;
+			if ( RESTARTER.due() ) {
 				watchedUndoTheory ( 0 );
-
-
-
-				restartCount = BACKTRACKS + restarts;
+				LEVEL = 0;
+				RESTARTER.restart();
 				RESTARTS++;
 			}
 			else watchedUndoTheory ( LEVEL );
 
+			// the learned clause is unit after backtracking, after a restart
+			// propagation leaves it alone unless it is unit at level 0
+			watchClause ( learnedId );
+			UNITLIST.push_back ( learnedId );
 
-					}
+			// the clauses of the other searches come in at the level 0
+			if ( EXCHANGE && LEVEL == 0 ) importClauses();
+		}
 
 		// If there is a unit clause, propagate
 
-
-		NewWatchedCheckUnit ();
-
 		if ( ! UNITLIST.empty() )
 			WatchedUnitPropagation();
-		// otherwise choose a literal and propagate - no need for separate unit propagation
-
-		else if ( UNITLIST.empty() && ! CONFLICT ) {
-		Literal * atom = NULL;
-			if ( VSIDS ) atom = chooseLiteralVSIDS();
-			else atom = lazyWatchedChooseLiteral ();
-
-			if ( atom ) {
-				DECISIONS++;
-				LEVEL++;
-				// set REASON for subsequent falsified atoms
-				UNITCLAUSE = -1;
-				if ( LOG ) cout << "Decision: " << atom -> VAR << ( atom -> EQUAL ? '=' : '!' ) << atom -> VAL << endl;
-				watchedReduceTheory ( atom, atom -> VAR, atom -> EQUAL, atom -> VAL );
-			}
-
-		}
-
-	}
-
-}
-
-int Formula::WatchedLiterals ( int restarts ) {
-
-
-	int restartCount = restarts;
-
-	// returns 0 if sat, 1 if timeout, 2 if unsat
-
-	if ( LOG ) cout << "Solving with the watched literal algorithm..." << endl;
-
-	while ( true ) {
-		//Check if the theory satisfied
-
-
-		if ( watchedCheckSat() == 1 )
-			return 0; //
-		//Check if time out
-		TIME_E = GetTime();
-	//	if ( ( TIME_E - TIME_S ) > TIMELIMIT )
-		//	return 1;
-
-		if ( CONFLICT ) {
-
-			if ( LOG ) {
-				cout << "There is a conflict at level: " << LEVEL << endl;
-				cout<<"Conflicting clause: "<<  endl;
-				CLAUSELIST[CONFLICTINGCLAUSE] -> Print ();
-			}
-
 
-			if ( LEVEL == 0 ) { cout << "UNSAT" << endl; return 2; }
+		// then the constraints, whose clauses are propagated in turn
+		if ( ! CONFLICT && propagateConstraints() ) continue;
 
-			Clause* learned = analyzeConflict ( CLAUSELIST[CONFLICTINGCLAUSE] );
-			LEVEL = backtrackLevel ( learned );
+		if ( ! CONFLICT ) {
 
-			if ( learned -> NumAtom > 1) {
-			learned -> WATCHED[1] = learned -> ATOM_LIST[WATCHED2];
-			}
+			// forget the least useful learned clauses now and then
+			if ( (int) CLAUSELIST.size() - ORIGINALCLAUSES >= NEXTREDUCE ) reduceDB();
+			// and those another learned clause subsumes, at the level 0 once half as many are new
+			if ( SUBSUMELEARNED && LEVEL == 0 && 2 * ( LEARNEDCLAUSES - SUBSUMEDAT ) > (int) CLAUSELIST.size() - ORIGINALCLAUSES )
+				subsumeLearned();
 
-			BACKTRACKS++;
-			if ( LOG ) {
-				cout << "We are backtracking to the level: " << LEVEL << endl;
-				cout << "# of backtracks so far: " << BACKTRACKS << endl;
+			// the assumptions are decided first, the heuristic chooses once they hold
+			LIT atom = decideAssumption();
+			if ( FAILEDASSUMPTION ) return 2;
+			if ( atom == NOLIT ) {
+				if ( EVSIDS ) atom = chooseLiteralHeap();
+				else if ( VSIDS ) atom = chooseLiteralVSIDS();
+				else {
+					atom = lazyWatchedChooseLiteral ();
+					// the clauses are satisfied, the constraints still need values
+					if ( atom == NOLIT && ! ( CONSTRAINTS.empty() && AMOS.empty() ) ) atom = chooseLiteralHeap();
+				}
+				atom = savedPhase ( atom );
 			}
-			CONFLICT = false;
-
-			if ( BACKTRACKS == restartCount ) {
-
-
-				//	cout << "restarting" << endl;
-				watchedUndoTheory ( 0 );
 
-
-
-				restartCount = BACKTRACKS + restarts;
-				RESTARTS++;
+			// nothing left to decide and no conflict: every clause has a true watch, and
+			// the variables of the constraints have values, so every constraint holds
+			if ( atom == NOLIT ) {
+				TIME_E = GetTime();
+				return 0;
 			}
-			else watchedUndoTheory ( LEVEL );
-
-
-					}
-
-		// If there is a unit clause, propagate
-
-
-		NewWatchedCheckUnit ();
-
-		if ( ! UNITLIST.empty() )
-			WatchedUnitPropagation();
 
-	 if ( ! CONFLICT ) {
-			Literal * atom = NULL;
-			if ( VSIDS ) atom = chooseLiteralVSIDS();
-			else atom = lazyWatchedChooseLiteral ();
-			if ( atom ) {
-				DECISIONS++;
-				LEVEL++;
-				// set REASON for subsequent falsified atoms
-				UNITCLAUSE = -1;
-				if ( LOG ) cout << "Decision: " << atom -> VAR << ( atom -> EQUAL ? '=' : '!' ) << atom -> VAL << endl;
-				watchedReduceTheory ( atom, atom -> VAR, atom -> EQUAL, atom -> VAL );
-			}
+			// the levels skipped by the assumptions hold nothing, they share the cursor
+			DECIDEFROMLIM.resize ( LEVEL + 1, DECIDEFROM );
+			DECIDEFROMLIM.push_back ( DECIDEFROM );
 
+			DECISIONS++;
+			LEVEL++;
+			// set REASON for subsequent falsified atoms
+			UNITCLAUSE = -1;
+			if ( LOG ) cout << "Decision: " << litVar ( atom ) << ( litEqual ( atom ) ? '=' : '!' ) << litVal ( atom ) << endl;
+			watchedReduceTheory ( atom, litVar ( atom ), litEqual ( atom ), litVal ( atom ) );
 		}
 	}
 }
 
-
-int Formula::tempWatchedLiterals ( int restarts ) {
-
-	int restartCount = restarts;
+int Formula::tempWatchedLiterals () {
 
 	// returns 0 if sat, 1 if timeout, 2 if unsat
 
@@ -2586,10 +3888,9 @@ int Formula::tempWatchedLiterals ( int restarts ) {
 		if ( tempwatchedCheckSat() == 1 )
 			return 0; //
 
-		//Check if time out
-		TIME_E = GetTime();
-	//	if ( ( TIME_E - TIME_S ) > TIMELIMIT )
-		//	return 1;
+		//Check if time out or out of memory
+		int limit = checkLimits();
+		if ( limit ) return limit;
 
 		if ( CONFLICT ) {
 
@@ -2600,9 +3901,9 @@ int Formula::tempWatchedLiterals ( int restarts ) {
 			}
 
 
-			if ( LEVEL == 0 ) { cout << "UNSAT" << endl; return 2; }
+			if ( LEVEL == 0 ) { if ( LOG ) cout << "UNSAT" << endl; return 2; }
 
-			Clause* learned = analyzeConflict ( CLAUSELIST[CONFLICTINGCLAUSE] );
+			Clause* learned = analyzeConflict ( CONFLICTINGCLAUSE );
 			LEVEL = backtrackLevel ( learned );
 
 			if ( learned -> NumAtom > 1) {
@@ -2617,39 +3918,43 @@ int Formula::tempWatchedLiterals ( int restarts ) {
 			}
 			CONFLICT = false;
 
-			if ( BACKTRACKS == restartCount ) {
-				//	cout << "restarting" << endl;
+			RESTARTER.conflict ( learned -> LBD );
+
+			if ( RESTARTER.due() ) {
 				watchedUndoTheory ( 0 );
-				restartCount = BACKTRACKS + restarts;
+				LEVEL = 0;
+				RESTARTER.restart();
 				RESTARTS++;
 			}
 			else watchedUndoTheory ( LEVEL );
-					}
+		}
 		// If there is a unit clause, propagate
-		Literal* unit = tempwatchedCheckUnit ();
+		LIT unit = tempwatchedCheckUnit ();
 		if ( unit ) {
 		/*	if ( LOG ) {
 				cout << "Found unit!" << endl;
-				unit -> Print();
+				printLit ( unit );
 				cout << "Unit clause: "<<endl;
 				CLAUSELIST[UNITCLAUSE] -> Print();
 			} */
-			watchedReduceTheory ( unit, unit -> VAR, unit -> EQUAL, unit -> VAL );
+			watchedReduceTheory ( unit, litVar ( unit ), litEqual ( unit ), litVal ( unit ) );
 
 		}
 		// otherwise choose a literal and propagate - no need for separate unit propagation
 		else if ( ! CONFLICT ) {
-			Literal * atom = NULL;
-			if ( VSIDS ) atom = chooseLiteralVSIDS();
+			LIT atom = NOLIT;
+			if ( EVSIDS ) atom = chooseLiteralHeap();
+			else if ( VSIDS ) atom = chooseLiteralVSIDS();
 			else atom = templazyWatchedChooseLiteral ();
+			atom = savedPhase ( atom );
 
 			if ( atom ) {
 				DECISIONS++;
 				LEVEL++;
 				// set REASON for subsequent falsified atoms
 				UNITCLAUSE = -1;
-				if ( LOG ) cout << "Decision: " << atom -> VAR << ( atom -> EQUAL ? '=' : '!' ) << atom -> VAL << endl;
-				watchedReduceTheory ( atom, atom -> VAR, atom -> EQUAL, atom -> VAL );
+				if ( LOG ) cout << "Decision: " << litVar ( atom ) << ( litEqual ( atom ) ? '=' : '!' ) << litVal ( atom ) << endl;
+				watchedReduceTheory ( atom, litVar ( atom ), litEqual ( atom ), litVal ( atom ) );
 			}
 
 		}
@@ -2670,15 +3975,17 @@ int Formula::NewNonChronoBacktrack() {
 	 return 2 : if CONFLICT and later used as unsatisfied
 	 */
 
+	// units and conflicts of the input, later ones are queued by removeLiteral
+	checkUnit();
+
 	while ( true ) {
 
 		if ( checkSat() )
 			return 0;
 
-		//Check if time out
-		TIME_E = GetTime();
-		if ( ( TIME_E - TIME_S ) > TIMELIMIT )
-			return 1;
+		//Check if time out or out of memory
+		int limit = checkLimits();
+		if ( limit ) return limit;
 
 		if ( CONFLICT ) {
 
@@ -2690,7 +3997,9 @@ int Formula::NewNonChronoBacktrack() {
 
 			if ( LEVEL == 0 ) return 2; // the formula is unsat
 
-			LEVEL = backtrackLevel ( analyzeConflict ( CLAUSELIST[CONFLICTINGCLAUSE]) );
+			Clause* learned = analyzeConflict ( CONFLICTINGCLAUSE );
+			if ( learned -> NumAtom == 0 ) { delete learned; return 2; }
+			LEVEL = backtrackLevel ( learned );
 
 			BACKTRACKS++;
 
@@ -2701,17 +4010,26 @@ int Formula::NewNonChronoBacktrack() {
 
 			CONFLICT = false;
 
-			undoTheory(LEVEL);
-
-		}
-
-		// If there is a unit clause, propagate
-
+			RESTARTER.conflict ( learned -> LBD );
 
-		checkUnit();
+			if ( RESTARTER.due() ) {
+				undoTheory ( 0 );
+				LEVEL = 0;
+				RESTARTER.restart();
+				RESTARTS++;
+			}
+			else undoTheory ( LEVEL );
 
+			// the learned clause is the only unit after backtracking, after a restart
+			// it is unit only if all its other atoms are falsified at level 0
+			UNITLIST.clear();
+			checkUnit ( CLAUSELIST.size() - 1 );
 
+			// the clauses of the other searches come in at the level 0
+			if ( EXCHANGE && LEVEL == 0 ) importClauses();
+		}
 
+		// If there is a unit clause, propagate
 
 		if ( !UNITLIST.empty() )
 		    unitPropagation();
@@ -2720,102 +4038,37 @@ int Formula::NewNonChronoBacktrack() {
 		// otherwise choose a literal and propagate
 		if ( !CONFLICT ) {
 
-			Literal* atom;
-			if (VSIDS)
+			// forget the least useful learned clauses now and then
+			if ( (int) CLAUSELIST.size() - ORIGINALCLAUSES >= NEXTREDUCE ) reduceDB();
+			// and those another learned clause subsumes, at the level 0 once half as many are new
+			if ( SUBSUMELEARNED && LEVEL == 0 && 2 * ( LEARNEDCLAUSES - SUBSUMEDAT ) > (int) CLAUSELIST.size() - ORIGINALCLAUSES )
+				subsumeLearned();
+
+			LIT atom;
+			if (EVSIDS)
+				atom = chooseLiteralHeap();
+			else if (VSIDS)
 				atom = chooseLiteralVSIDS();
 			else
 				atom = lazyChooseLiteral();
+			atom = savedPhase ( atom );
 			if ( atom ) {
 				DECISIONS++;
 				LEVEL++;
 
-				if (LOG) cout << "Decision: " << atom -> VAR << ( atom -> EQUAL ? '=' : '!' ) << atom -> VAL << endl;
+				if (LOG) cout << "Decision: " << litVar ( atom ) << ( litEqual ( atom ) ? '=' : '!' ) << litVal ( atom ) << endl;
 
 				UNITCLAUSE = -1; // REASON for the subsequent falsified atoms
 
-				reduceTheory ( atom -> VAR, atom -> EQUAL, atom -> VAL );
-			}
-
-		}
-	}
-
-}
-
-// // Resolution-based non-chronological backtracking algorithm  with restarts
-int Formula::NonChronoBacktrack ( int restarts ) {
-
-	int restartCount = restarts;
-
-	//start of finite domain extended dpll
-	// return 0 : if theory satisfied
-	// return 1 : if time out
-	// return 2 : if CONFLICT and later used as unsatisfied
-
-	while ( true ){
-
-		if ( checkSat() )
-			return 0;
-
-		//Check if time out
-		TIME_E = GetTime();
-		if ( (TIME_E - TIME_S ) > TIMELIMIT )
-			return 1;
-
-		if ( CONFLICT ) {
-
-			if ( LOG ) {
-				cout << "There is a conflict at level: " << LEVEL << endl;
-				cout << "Conflicting clause: " <<  endl;
-				CLAUSELIST[CONFLICTINGCLAUSE] -> Print();
+				reduceTheory ( litVar ( atom ), litEqual ( atom ), litVal ( atom ) );
 			}
 
-			if ( LEVEL == 0 ) return 2;
-
-			LEVEL = backtrackLevel ( analyzeConflict ( CLAUSELIST[CONFLICTINGCLAUSE]) );
-
-			if ( LOG ) cout << "We are backtracking to the level: " << LEVEL << endl;
-
-			BACKTRACKS++;
-			CONFLICT = false;
-
-			if ( LOG ) cout << "# of backtracks so far: " << BACKTRACKS << endl;
-
-
-			if ( BACKTRACKS == restartCount ) {
-				undoTheory ( 0 );
-				restartCount = BACKTRACKS + restarts;
-				RESTARTS++;
-			}
-			else undoTheory ( LEVEL );
 		}
-
-		// If there is a unit clause, propagate
-
-		checkUnit();
-
-		if ( !UNITLIST.empty() )
-			unitPropagation();
-
-		// otherwise choose a literal and propagate
-
-			Literal* atom = chooseLiteral();
-
-			if ( atom ) {
-
-				if (LOG) cout << "Decision: " << atom -> VAR << ( atom -> EQUAL ? '=' : '!' ) << atom -> VAL << endl;
-
-				DECISIONS++;
-				LEVEL++;
-				UNITCLAUSE = -1; // REASON for subsequent falsified atoms
-
-				reduceTheory ( atom -> VAR, atom -> EQUAL, atom -> VAL);
-			}
-
 	}
 
 }
 
-// Resolution-based non-chronological backtracking algorithm
+// Resolution-based non-chronological backtracking algorithm, restarts as the RESTARTER says
 
 int Formula::NonChronoBacktrack() {
 
@@ -2825,30 +4078,35 @@ int Formula::NonChronoBacktrack() {
 	 return 2 : if CONFLICT and later used as unsatisfied
 	 */
 
-	while ( true ) {
-
+	// units and conflicts of the input, later ones are queued by removeLiteral
+	checkUnit();
+	FAILEDASSUMPTION = false;
 
+	while ( true ) {
 
-		if ( checkSat() )
+		// a model must hold the assumptions and the constraints too, even once every
+		// clause is satisfied
+		if ( checkSat() && LEVEL >= (int) ASSUMPTIONS.size() && constraintsHold() )
 			return 0;
 
-
-		//Check if time out
-		TIME_E = GetTime();
-		if ( ( TIME_E - TIME_S ) > TIMELIMIT )
-			return 1;
+		//Check if time out or out of memory
+		int limit = checkLimits();
+		if ( limit ) return limit;
 
 		if ( CONFLICT ) {
 
 			if ( LOG ) {
 				cout << "There is a conflict at level: " << LEVEL << endl;
 				cout<<"Conflicting clause: "<<  endl;
-				CLAUSELIST[CONFLICTINGCLAUSE] -> Print();
+				if ( CONFLICTINGCLAUSE > AMOREASON ) CLAUSELIST[CONFLICTINGCLAUSE] -> Print();
+				else cout << "at most one constraint " << AMOREASON - CONFLICTINGCLAUSE << endl;
 			}
 
 			if ( LEVEL == 0 ) return 2; // the formula is unsat
 
-			LEVEL = backtrackLevel ( analyzeConflict ( CLAUSELIST[CONFLICTINGCLAUSE]) );
+			Clause* learned = analyzeConflict ( CONFLICTINGCLAUSE );
+			if ( learned -> NumAtom == 0 ) { delete learned; return 2; }
+			LEVEL = backtrackLevel ( learned );
 
 			BACKTRACKS++;
 
@@ -2859,38 +4117,63 @@ int Formula::NonChronoBacktrack() {
 
 			CONFLICT = false;
 
-			undoTheory(LEVEL);
-
-		}
-
-		// If there is a unit clause, propagate
-
+			RESTARTER.conflict ( learned -> LBD );
 
-		checkUnit();
+			if ( RESTARTER.due() ) {
+				undoTheory ( 0 );
+				LEVEL = 0;
+				RESTARTER.restart();
+				RESTARTS++;
+			}
+			else undoTheory ( LEVEL );
 
+			// the learned clause is the only unit after backtracking, after a restart
+			// it is unit only if all its other atoms are falsified at level 0
+			UNITLIST.clear();
+			checkUnit ( CLAUSELIST.size() - 1 );
 
+			// the clauses of the other searches come in at the level 0
+			if ( EXCHANGE && LEVEL == 0 ) importClauses();
+		}
 
+		// If there is a unit clause, propagate
 
 		if ( !UNITLIST.empty() )
 			unitPropagation();
 
+		// then the constraints, whose clauses are propagated in turn
+		if ( !CONFLICT && propagateConstraints() ) continue;
+
 		// otherwise choose a literal and propagate
 		if ( !CONFLICT ) {
 
-			Literal* atom;
-			if (VSIDS)
-				atom = chooseLiteralVSIDS();
-			else
-				atom = chooseLiteral();
+			// forget the least useful learned clauses now and then
+			if ( (int) CLAUSELIST.size() - ORIGINALCLAUSES >= NEXTREDUCE ) reduceDB();
+			// and those another learned clause subsumes, at the level 0 once half as many are new
+			if ( SUBSUMELEARNED && LEVEL == 0 && 2 * ( LEARNEDCLAUSES - SUBSUMEDAT ) > (int) CLAUSELIST.size() - ORIGINALCLAUSES )
+				subsumeLearned();
+
+			// the assumptions are decided first, the heuristic chooses once they hold
+			LIT atom = decideAssumption();
+			if ( FAILEDASSUMPTION ) return 2;
+			if ( atom == NOLIT ) {
+				if (EVSIDS)
+					atom = chooseLiteralHeap();
+				else if (VSIDS)
+					atom = chooseLiteralVSIDS();
+				else
+					atom = chooseLiteral();
+				atom = savedPhase ( atom );
+			}
 			if ( atom ) {
 				DECISIONS++;
 				LEVEL++;
 
-				if (LOG) cout << "Decision: " << atom -> VAR << ( atom -> EQUAL ? '=' : '!' ) << atom -> VAL << endl;
+				if (LOG) cout << "Decision: " << litVar ( atom ) << ( litEqual ( atom ) ? '=' : '!' ) << litVal ( atom ) << endl;
 
 				UNITCLAUSE = -1; // REASON for the subsequent falsified atoms
 
-				reduceTheory ( atom -> VAR, atom -> EQUAL, atom -> VAL );
+				reduceTheory ( litVar ( atom ), litEqual ( atom ), litVal ( atom ) );
 			}
 
 		}
@@ -2907,72 +4190,134 @@ int Formula::ChronoBacktrack(int level)
 	// return 1 : if time out
 	// return 2 : if conflict and later used as unsatisfied
 
-	//set LEVEL
+	//the assumptions take the levels above level, a conflict among them
+	//fails the search under them
 	LEVEL = level;
-
-	//check if theory satisfied or not
-	if(checkSat())
-		return 0;
-
-	//check if time out
-	TIME_E = GetTime();
-	if((TIME_E - TIME_S) > TIMELIMIT)
-		return 1;
-
-	//check unit literal
-	if(!UNITLIST.empty())
-		unitPropagation();
-	//check if theory satisfied or not
-	if(checkSat())
-		return 0;
-
-	//check if time out
-	TIME_E = GetTime();
-	if((TIME_E - TIME_S) > TIMELIMIT)
-		return 1;
-
-	//check if conflict
+	FAILEDASSUMPTION = false;
+	UNITLIST.clear();
+	for(unsigned int i = 0; i < ASSUMPTIONS.size() && !CONFLICT; i++)
+	{
+		LIT atom = ASSUMPTIONS[i];
+		LEVEL++;
+		if(sat(atom) == 0)
+			CONFLICT = true;
+		else if(sat(atom) == 2)
+		{
+			UNITCLAUSE = -1;
+			reduceTheory(litVar ( atom ), litEqual ( atom ), litVal ( atom ));
+			if(!CONFLICT)
+				unitPropagation();
+		}
+	}
 	if(CONFLICT)
 	{
-		BACKTRACKS++;
+		FAILEDASSUMPTION = true;
 		CONFLICT = false;
-		undoTheory(LEVEL-1);
-		LEVEL = LEVEL-1;
+		UNITLIST.clear();
+		undoTheory(level-1);
+		LEVEL = level-1;
 		return 2;
 	}
 
-	//since all is fine, now need to choose a literal
-	//to branch on
-	Literal * atom = NULL;
-
-	if (VSIDS)
-		atom = chooseLiteralVSIDS();
-	else
-		atom = lazyChooseLiteral();
+	//the decisions are kept in BRANCHES instead of the C++ stack, the one of
+	//BRANCHES[i] is at the level base+i+1 and its negation replaces it there
+	int base = LEVEL;
+	BRANCHES.clear();
 
-	if(atom)
+	while(true)
 	{
-		DECISIONS++;
-		LEVEL++;
-		reduceTheory(atom->VAR, atom->EQUAL, atom->VAL);
-		int result = ChronoBacktrack(LEVEL);
-		if(result == 0)
+		//check if theory satisfied or not
+		if(checkSat())
+			return 0;
+
+		//check if time out or out of memory
+		int limit = checkLimits();
+		if(limit)
+			return limit;
+
+		//check unit literal
+		if(!UNITLIST.empty())
+			unitPropagation();
+		//check if theory satisfied or not
+		if(checkSat())
 			return 0;
-		else if(result == 1)
-			return 1;
-		else if((result == 2) && (LEVEL != 0))
+
+		//check if conflict
+		if(CONFLICT)
 		{
-			reduceTheory(atom->VAR, !atom->EQUAL, atom->VAL);
-			return ChronoBacktrack(LEVEL);
+			BACKTRACKS++;
+			CONFLICT = false;
+			UNITLIST.clear();
+
+			//the latest decision whose other branch is still open
+			while(!BRANCHES.empty() && !BRANCHES.back().OPEN)
+				BRANCHES.pop_back();
+			if(BRANCHES.empty())
+			{
+				undoTheory(level-1);
+				LEVEL = level-1;
+				return 2;
+			}
+
+			CHRONOFRAME & frame = BRANCHES.back();
+			frame.ATOM = makeLit ( litVar ( frame.ATOM ), !litEqual ( frame.ATOM ), litVal ( frame.ATOM ) );
+			frame.OPEN = false;
+			LEVEL = base + BRANCHES.size();
+			undoTheory(LEVEL-1);
+			UNITCLAUSE = -1;
+			reduceTheory(litVar ( frame.ATOM ), litEqual ( frame.ATOM ), litVal ( frame.ATOM ));
+			continue;
 		}
+
+		//another thread waits for work
+		if(TASKS && TASKS->wanted(SHAREID))
+			donateBranch();
+
+		//since all is fine, now need to choose a literal
+		//to branch on
+		LIT atom = NOLIT;
+
+		if (VSIDS)
+			atom = chooseLiteralVSIDS();
 		else
-			return 2;
+			atom = lazyChooseLiteral();
+
+		if(!atom)
+		{
+			cout<<"No Branch Atom selected"<<endl;
+			return 0;
+		}
+
+		DECISIONS++;
+		CHRONOFRAME frame;
+		frame.ATOM = atom;
+		frame.OPEN = true;
+		BRANCHES.push_back(frame);
+		LEVEL = base + BRANCHES.size();
+		UNITCLAUSE = -1;
+		reduceTheory(litVar ( atom ), litEqual ( atom ), litVal ( atom ));
 	}
-	else
+}
+
+void Formula::donateBranch()
+{
+	//the oldest open branch heads the largest subtree left, the task is the
+	//path down to it: the assumptions, the atoms of the levels above, then
+	//the other branch
+	for(unsigned int i = 0; i < BRANCHES.size(); i++)
 	{
-		cout<<"No Branch Atom selected"<<endl;
+		if(!BRANCHES[i].OPEN)
+			continue;
+		vector <LIT> task ( ASSUMPTIONS );
+		for(unsigned int j = 0; j < i; j++)
+			task.push_back ( BRANCHES[j].ATOM );
+		LIT atom = BRANCHES[i].ATOM;
+		task.push_back ( makeLit ( litVar ( atom ), !litEqual ( atom ), litVal ( atom ) ) );
+		BRANCHES[i].OPEN = false;
+		TASKS->push ( SHAREID, task );
+		DONATED++;
+		return;
 	}
-	return 0;
 }
 
 bool Formula::unitPropagation()
@@ -2996,9 +4341,9 @@ bool Formula::unitPropagation()
 		{
 			for(int i=0; i<CLAUSELIST[unit_clause]->NumAtom && !flag; i++)
 			{
-				lit_var = CLAUSELIST[unit_clause]->ATOM_LIST[i]->VAR;
-				lit_equal = CLAUSELIST[unit_clause]->ATOM_LIST[i]->EQUAL;
-				lit_val = CLAUSELIST[unit_clause]->ATOM_LIST[i]->VAL;
+				lit_var = litVar ( CLAUSELIST[unit_clause]->ATOM_LIST[i] );
+				lit_equal = litEqual ( CLAUSELIST[unit_clause]->ATOM_LIST[i] );
+				lit_val = litVal ( CLAUSELIST[unit_clause]->ATOM_LIST[i] );
 				if(VARLIST[lit_var]->ATOMASSIGN[lit_val] == 0)
 				{
 					flag = true;
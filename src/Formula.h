@@ -22,14 +22,96 @@
 #include <string>
 #include <list>
 #include <vector>
+#include <atomic>
 
 #include "Global.h"
 #include "Literal.h"
 #include "Variable.h"
 #include "Clause.h"
+#include "Heap.h"
+#include "Restart.h"
+#include "Share.h"
+#include "Steal.h"
+#include "AllDifferent.h"
+#include "Table.h"
+#include "AtMostOne.h"
 
 using namespace std;
+
+//Result of a search whose clauses took more memory than allowed, next
+//to 0 sat, 1 timeout and 2 unsat
+#define MEMOUT 4
+//Result of a search whose input could not be read, e.g. a malformed cube file
+#define INPUTERROR 5
+//Reason of an atom falsified by the at most one constraint c, and conflict
+//of c, given as AMOREASON - c in place of a clause number
+#define AMOREASON -11
+
 //**************************************************************
+// TRAILRECORD
+// This is an entry of the assignment trail, the variable and the
+// domain value of an atom that got assigned
+struct TRAILRECORD
+{
+  int var;
+  int val;
+};
+
+// CHRONOFRAME
+// This is a decision of the chronological search, the atom that
+// holds at its level and whether the other branch is still to be
+// searched
+struct CHRONOFRAME
+{
+  LIT ATOM;
+  bool OPEN;
+};
+
+// BINARYHEADER
+// This is the start of an instance in the binary format written by
+// -f2bin. It is followed by the domain size of each variable, padded
+// to 8 bytes, then NUMCLAUSE+1 offsets of 8 bytes giving where each
+// clause starts in the literals, then the NUMLIT packed literals of
+// all the clauses. Numbers are in the byte order of the machine that
+// wrote the file; VERSION does not match on another byte order
+#define BINARYMAGIC "MVLB"
+#define BINARYVERSION 1
+struct BINARYHEADER
+{
+  char MAGIC[4];
+  unsigned int VERSION;
+  unsigned int NUMVAR;
+  unsigned int NUMCLAUSE;
+  unsigned long long NUMLIT;
+};
+//binaryAlign : rounds a number of bytes up to a multiple of 8
+inline size_t binaryAlign(size_t bytes) { return (bytes + 7) & ~(size_t) 7; }
+
+// CLAUSELINES
+// These are the clause lines of the input, parsed into the literals
+// of its clauses one after the other and the size of each clause, the
+// variables of its alldifferent constraints and the atoms of its at
+// most one constraints, with the number of each one, and the
+// variables and the tuples allowed of its table constraints, with
+// their numbers. ERROR and ERRORPOS describe the first error
+struct CLAUSELINES
+{
+  const char * BEGIN;
+  const char * END;
+  vector <LIT> LITS;
+  vector <int> SIZES;
+  vector <int> ALLDIFFVARS;
+  vector <int> ALLDIFFSIZES;
+  vector <LIT> AMOLITS;
+  vector <int> AMOSIZES;
+  vector <int> TABLEVARS;
+  vector <int> TABLEARITIES;
+  vector <int> TABLETUPLES;
+  vector <int> TABLESIZES;
+  const char * ERROR;
+  const char * ERRORPOS;
+};
+
 // Formula
 // This class represents the Formula object for the solver
 // which stores all the variables, all the clauses in the theory,
@@ -42,7 +124,11 @@ class Formula
 public:
   //VARLIST = list of all the variables
   //CLAUSELIST = list of all the clauses in the theory
+  //INPUTARENA = storage of the literals of the clauses of the input
+  //ARENA = storage of the literals of the learned clauses
   //TIMELIMIT = amount of time allowed for solving before timing out
+  //MEMLIMIT = memory allowed for the clauses, in megabytes, 0 for no limit
+  //LIMITCOUNT = number of checks of the limits since the clock was last read
   //TIME_S = starting time of solving
   //TIME_E = end time of solving
   //LEVEL = stores the current level
@@ -55,10 +141,36 @@ public:
   //UNITCLAUSE = clause that just got unit and satisfied
   //CONFLICT = boolean variable true when conflict in theory
   //CONFLICTINGCLAUSE = clause that is causing conflict in theory
+  //UNSATCLAUSES = number of clauses in CLAUSELIST not satisfied yet
   //DECSTACK = stores the decisions/implications made in order
+  //TRAIL = stores every atom assigned, in the order of assignment
+  //TRAILLIM = stores the position in TRAIL at which each level starts
+  //DECIDEFROM = the clauses before it have a true watch, the watched literal
+  //             engine looks for its next decision from there
+  //DECIDEFROMLIM = DECIDEFROM when the decision of each level was made
+  //OCCARRAY = flat array of the clause numbers in which each atom occurs,
+  //           sliced into the occurrence lists of the variables
+  //ATOMHEAP = activities of the atoms for the exponential vsids heuristic
+  //ATOMBASE = number of the first atom of each variable, atoms are numbered
+  //           var by var
+  //HEAPLIT = the atom of each number in ATOMHEAP
+  //RESOLVENT = the clause being resolved while analyzing a conflict
+  //REASON = the reason clause built for a decision or an entailment
+  //SEEN = the step of the analysis at which each literal was put in RESOLVENT
+  //SEENSTAMP = the current step of the analysis
+  //ORIGINALCLAUSES = number of clauses of the input, the learned clauses follow
+  //                  them in CLAUSELIST
+  //LEARNEDCLAUSES = number of clauses learned so far
+  //DELETEDCLAUSES = number of learned clauses deleted so far
+  //NEXTREDUCE = number of learned clauses at which the next reduction is done
+  //CLAUSEINC = amount added to the activity of a bumped learned clause
   vector<Variable *> VARLIST;
   vector<Clause *> CLAUSELIST;
+  ClauseArena INPUTARENA;
+  ClauseArena ARENA;
   int TIMELIMIT;
+  int MEMLIMIT;
+  int LIMITCOUNT;
   double TIME_S;
   double TIME_E;
   int LEVEL;
@@ -66,18 +178,112 @@ public:
   int DECISIONS;
   int UNITS;
   int ENTAILS;
-  Literal * ENTAILLITERAL;
+  LIT ENTAILLITERAL;
   list <int> UNITLIST;
   int UNITCLAUSE;
-  int LASTFALSE; // for potent fn
+  int LASTFALSE; // position of the atom of the current level in the learned clause
   bool CONFLICT;
   int CONFLICTINGCLAUSE;
-  vector <Literal *> DECSTACK;
+  int UNSATCLAUSES;
+  vector <LIT> DECSTACK;
+  vector <TRAILRECORD> TRAIL;
+  vector <int> TRAILLIM;
+  int DECIDEFROM;
+  vector <int> DECIDEFROMLIM;
+  vector <int> OCCARRAY;
+  AtomHeap ATOMHEAP;
+  vector <int> ATOMBASE;
+  vector <LIT> HEAPLIT;
+  vector <LIT> RESOLVENT;
+  vector <LIT> REASON;
+  vector <int> SEEN;
+  int SEENSTAMP;
+  int ORIGINALCLAUSES;
+  int LEARNEDCLAUSES;
+  int DELETEDCLAUSES;
+  int NEXTREDUCE;
+  double CLAUSEINC;
   int RESTARTS;
+  RestartScheduler RESTARTER; //decides when the search restarts from the level 0
   bool LOG; // verbose
   bool WATCH; //watched literals option
   bool CMV; //watched literals option
   bool VSIDS; //vsids option
+  bool EVSIDS; //exponential vsids option, with the activity heap
+  bool PHASE; //phase saving option
+  bool SUBSUME; //simplification of the clauses of the input option
+  bool SUBSUMELEARNED; //simplification of the learned clauses at the restarts option
+  unsigned int SEED; //seed of the random tie breaking of the heap, 0 for none
+  const atomic<bool> * STOP; //set by another thread to stop the search, NULL if none
+  //EXCHANGE = learned clauses shared with the other searches of a portfolio, NULL if none
+  //SHAREID = number of the ring of this search in EXCHANGE
+  //SHARESIZE = learned clauses of at most this many atoms are exported
+  //SHARELBD = learned clauses over at most this many levels are exported
+  //EXPORTED, IMPORTED = number of clauses sent to and taken from the other searches
+  //USEDIMPORTS = number of imported clauses that took part in a conflict analysis
+  //IMPORTATOMS, IMPORTSIZES, IMPORTLBDS = the clauses taken from EXCHANGE at once
+  ClauseExchange * EXCHANGE;
+  int SHAREID;
+  int SHARESIZE;
+  int SHARELBD;
+  int EXPORTED;
+  int IMPORTED;
+  int USEDIMPORTS;
+  vector <LIT> IMPORTATOMS;
+  vector <int> IMPORTSIZES;
+  vector <int> IMPORTLBDS;
+  //ASSUMPTIONS = atoms decided first, one per level in this order, before the
+  //              heuristic decides; the learned clauses stay valid without them
+  //FAILEDASSUMPTION = true if the last search found an assumption falsified,
+  //                   its UNSAT then only holds under the assumptions
+  vector <LIT> ASSUMPTIONS;
+  bool FAILEDASSUMPTION;
+  //BRANCHES = the decisions of the chronological search above its assumptions,
+  //           one per level, used instead of recursion
+  //TASKS = pool the chronological search gives subtrees to when other threads
+  //        wait for work, NULL if none; SHAREID is the deque of this search
+  //DONATED = number of subtrees given to TASKS
+  vector <CHRONOFRAME> BRANCHES;
+  TaskPool * TASKS;
+  int DONATED;
+  //CONSTRAINTS = the alldifferent and table constraints, propagated by the counting
+  //              and the watched literal engines and turned into clauses for the others
+  //VARCONSTRAINTS = the constraints over each variable
+  //CONSTRAINTTRAIL = position in TRAIL up to which the constraints saw the assignments
+  //DIRTY = the constraints over a variable assigned since their last propagation
+  //ISDIRTY = true for the constraints in DIRTY
+  //EXPLAINED = number of clauses added to explain what the alldifferent and
+  //            table constraints propagated
+  //EXPLAINATOMS, EXPLAINSIZES = the clauses of the last propagation of the constraints
+  //PROPAGATED = the position in TRAIL each constraint was propagated at, and the
+  //             constraint, so a backtrack only undoes those propagated after it
+  vector <Constraint *> CONSTRAINTS;
+  vector < vector <int> > VARCONSTRAINTS;
+  int CONSTRAINTTRAIL;
+  vector < pair <int, int> > PROPAGATED;
+  vector <int> DIRTY;
+  vector <bool> ISDIRTY;
+  int EXPLAINED;
+  vector <LIT> EXPLAINATOMS;
+  vector <int> EXPLAINSIZES;
+  //AMOS = the at most one constraints, propagated by the same engines as the
+  //       alldifferent ones, their explanations built by the conflict analysis
+  //AMOFALSIFIED = the atoms an at most one constraint falsified in one step
+  //LITAMOS = the at most one constraints over each literal, by variable then
+  //          2 * value + 1 for = and 2 * value for !
+  vector <AtMostOne *> AMOS;
+  vector <LIT> AMOFALSIFIED;
+  vector < vector < vector <int> > > LITAMOS;
+  //SUBSUMEDAT = number of clauses learned when the learned clauses were last simplified
+  //DUPLICATES = number of clauses deleted as they repeat another one
+  //SUBSUMED = number of clauses deleted as another one subsumes them
+  //STRENGTHENED = number of values taken from the variables of clauses of the input
+  //TAUTOLOGIES = number of clauses deleted as they let a variable take any value
+  int SUBSUMEDAT;
+  int DUPLICATES;
+  int SUBSUMED;
+  int STRENGTHENED;
+  int TAUTOLOGIES;
 
   int WATCHED2; // temp, to fix wl algo
   //public variables and functions
@@ -87,12 +293,50 @@ public:
   Formula (CommandLine * cline);
   // 2-arg constructor
   Formula(int vars, int clauses);
-  //BuildFunction : builds the theory using the input cnf file
-  bool falsifies ( Literal* literal1, Literal* literal2 );
-  int sat (Literal* literal);
-  bool hasAtom(Clause * clause, Literal * atom);
+  //Destructor
+  ~Formula();
+  bool falsifies ( LIT literal1, LIT literal2 );
+  int sat (LIT literal);
   void watchedUndoTheory ( int level );
-  void BuildFormula(CommandLine * cline);
+  //BuildFormula : builds the theory using the input cnf file, returns false
+  //               after reporting the error if it cannot be read or is malformed;
+  //               the formula must then only be deleted
+  bool BuildFormula(CommandLine * cline);
+  //parseFormula : builds the theory from the text of an input file, length bytes
+  //               long, returns false as BuildFormula does
+  bool parseFormula(const char * text, size_t length);
+  //addInputClause : adds a clause of the input, its atoms already stored in the arena
+  void addInputClause(LIT * atoms, int size);
+  //initWatches : sets up the watched literals of a clause of the input
+  void initWatches(int c_num);
+  //parseClauseLines : parses the clause lines of the input
+  void parseClauseLines(CLAUSELINES & lines);
+  //finishFormula : builds what the search needs once all clauses are read
+  void finishFormula();
+  //loadBinary : builds the theory from an input file in the binary format,
+  //             returns false if it is malformed
+  bool loadBinary(const char * text, size_t length);
+  //shareClauses : builds the theory over the input clauses of another formula
+  void shareClauses(const Formula * master);
+  //stopped : returns true if another thread asked the search to stop
+  bool stopped() const { return STOP != NULL && STOP -> load ( memory_order_relaxed ); }
+  //checkLimits : returns 1 once the search is stopped or its time is up, MEMOUT
+  //              once its clauses take more memory than allowed, 0 otherwise
+  int checkLimits();
+  //memoryUsed : bytes taken by the clauses, their literals and their occurrences
+  long memoryUsed() const;
+  //readCubes : reads the cubes of a cube file, one per line, each a list of atoms,
+  //            returns false if it cannot be read or is malformed
+  bool readCubes(const char * file, vector < vector <LIT> > & cubes);
+  //writeCubes : writes the cubes into a cube file
+  void writeCubes(const char * file, const vector < vector <LIT> > & cubes);
+  //writeBinary : writes the clauses of the theory in the binary format
+  void writeBinary(const char * file);
+  //buildOccurrences : counts the atoms of the clauses and builds their occurrence lists
+  void buildOccurrences();
+  //simplifyClauses : deletes the clauses of the input that repeat or are subsumed
+  //                  by another one and strengthens the others, before finishFormula
+  void simplifyClauses();
   //PrintVar : prints the variable and its value
   void PrintVar();
   //PrintClause : prints the clauses in the theory
@@ -102,50 +346,63 @@ public:
   // Print model
   void PrintModel();
 int NewNonChronoBacktrack();
-  int NewWatchedCheckSat ();
   //verifyModel : verifies the model that was found, if any. returns true
   //if corret
   bool verifyModel();
   //checkSat : returns true if theory satisfied else false
   bool checkSat();
-  int watchedCheckSat(); // 1 sat, 0 falsif, 2 continue
   //checkConflict : return an integer value representing the conflict
   //clause else returns -1
   int checkConflict();
   //checkUnit : checks for unit clauses and adds clause id to unitlist
   void checkUnit();
-  Literal* watchedCheckUnit();
+  //checkUnit : checks one clause for being unit or conflicting
+  void checkUnit(int c_num);
   //checkEntail : checks for entailed atom if any in the theory and
   //stores info in ENTAILLITEAL, returns true if finds one
   bool checkEntail(int var);
   //chooseLiteral : selects next branching literal from the current theory
   void addReason(int var, int val); // needed for analyzing coflict
-  Literal* chooseLiteral();
+  LIT chooseLiteral();
   // choose random unassigned literal
-  Literal* lazyChooseLiteral();
-  void NewWatchedCheckUnit ();
+  LIT lazyChooseLiteral();
+  //decideAssumption : returns the next assumption to decide, NOLIT if there
+  //is none left or one is falsified, which sets FAILEDASSUMPTION
+  LIT decideAssumption();
+  //resetSearch : goes back to the level 0 after a search, keeps the learned clauses
+  void resetSearch();
+  //probe : assigns the atom at a new level and propagates, then takes it back,
+  //returns the number of clauses it satisfied or -1 on a conflict
+  int probe(LIT atom);
+  //savedPhase : turns a decision on a variable into one on its saved value
+  LIT savedPhase(LIT atom);
 void WatchedUnitPropagation();
-int NewWatchedLiterals ( int restarts );
-  Literal* chooseLiteralVSIDS();
-  Literal* watchedChooseLiteral();
-  void SwapPointer( Clause* clause );
-  void SwapPointer( int clause );
+  LIT chooseLiteralVSIDS();
+  //numberAtoms : fills ATOMBASE and makes room for the SEEN markers
+  void numberAtoms();
+  //buildHeap : fills ATOMHEAP with the atoms
+  void buildHeap();
+  //chooseLiteralHeap : selects the unassigned atom with the highest activity
+  LIT chooseLiteralHeap();
+  LIT watchedChooseLiteral();
 
   //reduceTheory : reduces the theory by satisfying literals/clauses
   void reduceTheory(int var, bool equals, int val);
-  void watchedReduceTheory(Literal * literal, int var, bool equals, int val);
+  void watchedReduceTheory(LIT literal, int var, bool equals, int val);
 
   //satisfyClauses : reduces the theory by satisfying the clauses
-  void watchedSatisfyLiteral(Literal * literal);
-
   void satisfyClauses(int var, bool equals, int val);
   //removeLiteral : reduces the theory by removing literals from the claues
   void removeLiteral(int var, bool equals, int val);
-  void watchedFalsifyLiteral(Literal * literal);
+  //watchedFalsifyLiteral : visits the clauses watching the falsified literal,
+  //moves their watches and queues units and conflicts
   void watchedFalsifyLiteral(int var, bool equals, int val);
-  void watchedSatisfyLiteral(int var, bool equals, int val);
+  //watchClause : adds the clause to the watch lists of its watched literals
+  void watchClause ( int c_num );
   // Assign watched literals to a (learned) clause
   void assignWatched ( Clause* clause );
+  //pushTrail : records the assignment of an atom at the current level
+  void pushTrail(int var, int val);
   //undoTheory : brings the theory back at the level stage
   void undoTheory(int level);
   //unsatisfyClauses : brings back the clauses that were satisfied before
@@ -154,31 +411,106 @@ int NewWatchedLiterals ( int restarts );
   //addLiteral : adds literal reduced when satisfying other literal
   void addLiteral(int var, bool equals, int val);
   //analyzeConflict : finds the conflict, learns and creates a conflict clause,
-  //add's the clause to theory and returns a backtrack level
-  Clause * analyzeConflict(Clause * clause);
-  bool potent(Clause * clause);
+  //add's the clause to theory and returns a backtrack level; conflict is the
+  //number of the falsified clause, or AMOREASON - c for a conflict of the at
+  //most one constraint c
+  Clause * analyzeConflict(int conflict);
   int backtrackLevel(Clause * clause);
-  //resolve: Extended resolution
-  Clause * resolve(Clause * clause, Literal * literal, Clause * reason);
-  //maxLit: return the literal in C that was falsified last (?)
-  vector<int> maxLit(Clause * clause);
+  //exportClause : sends a learned clause to the other searches if it is short enough
+  void exportClause(Clause * clause);
+  //importClauses : adds the clauses learned by the other searches, at the level 0
+  void importClauses();
+  //attachClause : adds a clause at the level 0, its atoms copied into the arena,
+  //               and returns its number
+  int attachClause(const LIT * atoms, int size, ClauseArena & arena);
+  //addRootClauses : adds clauses of the input at the level 0, after a search,
+  //                 the atoms of all of them one after the other
+  void addRootClauses(const vector <LIT> & atoms, const vector <int> & sizes);
+  //addVariable : adds a variable with the domain 0..domainsize-1, after a search
+  void addVariable(int domainsize);
+  //addAllDifferent : adds an alldifferent constraint over the variables
+  void addAllDifferent(const vector <int> & vars);
+  //addConstraint : adds a constraint to propagate, which the formula deletes
+  void addConstraint(Constraint * constraint);
+  //addTable : adds a table constraint over the variables allowing the tuples,
+  //           their values one after the other
+  void addTable(const vector <int> & vars, const vector <int> & tuples);
+  //addAtMostOne : adds an at most one constraint over the atoms, before the search
+  void addAtMostOne(const vector <LIT> & atoms);
+  //undoConstraints : uncounts the atoms of TRAIL from stop on, before they are
+  //                  unassigned
+  void undoConstraints(int stop);
+  //propagateConstraints : propagates the constraints over the variables assigned
+  //                       since the last call, returns true if it assigned an
+  //                       atom, found a conflict or added clauses explaining one
+  bool propagateConstraints();
+  //assignReason : assigns the atom as the unit propagation does, with reason
+  //               in place of the unit clause
+  void assignReason(LIT atom, int reason);
+  //explainAtMostOne : puts in REASON the clause of two atoms the at most one
+  //                   constraint c falsified the atom of var and val by
+  void explainAtMostOne(int c, int var, int val);
+  //conflictAtMostOne : puts in RESOLVENT the falsified clause of two atoms of
+  //                    the at most one constraint c that hold
+  void conflictAtMostOne(int c);
+  //addExplanation : adds a clause explaining a propagation of a constraint, unit
+  //                 or falsified at the current level, and queues it
+  void addExplanation(const LIT * atoms, int size);
+  //constraintsHold : returns true if every variable of every constraint has a
+  //                  value and the values satisfy the constraints
+  bool constraintsHold();
+  //decomposeConstraints : replaces the constraints by clauses of the input, for
+  //                       the engines that do not propagate them
+  void decomposeConstraints();
+  //countImported : counts an imported clause the first time it is used in a conflict
+  void countImported(Clause * clause);
+  //computeLBD : number of different levels of the atoms of the clause
+  int computeLBD(Clause * clause);
+  //bumpClause : increases the activity of a learned clause
+  void bumpClause(Clause * clause);
+  //reduceDB : deletes the least useful half of the learned clauses
+  void reduceDB();
+  //lockLearned : sets locked to true for the learned clauses that are reasons
+  //              of assigned atoms, which must not be deleted
+  void lockLearned(vector<bool> & locked);
+  //deleteLearned : deletes the learned clauses and renumbers the others
+  void deleteLearned(const vector<int> & clauses);
+  //subsumeLearned : deletes the learned clauses that repeat or are subsumed by
+  //                 another learned clause, at the level 0
+  void subsumeLearned();
+  //renumberClauses : drops deleted clauses from a list of clause numbers
+  //and renumbers the others
+  void renumberClauses(vector<int> & clauses, const vector<int> & newId);
+  //renumberTheory : renumbers the learned clauses in the occurrence lists,
+  //the watch lists and the reasons, newId gives the new number of each
+  void renumberTheory(const vector<int> & newId);
+  //renumberCursor : the new number of the first clause kept from cursor on
+  int renumberCursor(int cursor, const vector<int> & newId);
+  //resolve : extended resolution of RESOLVENT with the reason wrt literal
+  void resolve(LIT literal, const LIT * reason, int size);
+  //atomId : number of the literal, used to index SEEN
+  int atomId(LIT atom);
   //unitPropagation : does BCP in Finite Domain, returns true if no conflict
   //else returns false
-  bool LitIsEqual(Literal * literal1, Literal * literal2);
+  bool LitIsEqual(LIT literal1, LIT literal2);
   bool unitPropagation();
   // find unit literal in the unit clause
-  Literal * unitLiteral(Clause * clause);
+  LIT unitLiteral(Clause * clause);
   //NonChronoBacktrack : Extended DPLL algorithm with clause learning and
   //non chronological backtracking, returns backtrack level
   int NonChronoBacktrack();
-  int NonChronoBacktrack(int restarts);
 
   int NonChronoBacktrackLoop(int level);
-  //ChronoBacktrack : Extended DPLL algorithm without any learning
+  //ChronoBacktrack : Extended DPLL algorithm without any learning, searches
+  //under the assumptions decided from the level
   int ChronoBacktrack(int level);
+  //donateBranch : gives the oldest branch still open to TASKS
+  void donateBranch();
   // watched literals algo from Jain:
-  int WatchedLiterals( int restarts );
-  Literal* lazyWatchedChooseLiteral ();
+  int WatchedLiterals();
+  //lazyWatchedChooseLiteral : the unassigned first watch of the first clause
+  //without a true watch, NOLIT if every clause has one
+  LIT lazyWatchedChooseLiteral ();
 
   // CMV watched literals algorithm:
 
@@ -189,10 +521,10 @@ int NewWatchedLiterals ( int restarts );
   int tempwatchedCheckSat () ;
   inline void tempwatchedSatisfyLiteral ( int var, bool equals, int val );
 
-  Literal* tempwatchedCheckUnit () ;
-  Literal * templazyWatchedChooseLiteral ();
-  int tempWatchedLiterals ( int restarts );
-  inline void tempwatchedSatisfyLiteral( Literal * literal );
+  LIT tempwatchedCheckUnit () ;
+  LIT templazyWatchedChooseLiteral ();
+  int tempWatchedLiterals ();
+  inline void tempwatchedSatisfyLiteral( LIT literal );
   bool supported ( int var, Clause * clause ) ;
 
 };
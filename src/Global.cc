@@ -47,6 +47,7 @@ void PrintHelp()
 		cout<<" (4) Convert Boolean to Finite "<<endl;
 		cout<<" (5) Convert Finite to Boolean : Linear Encoding"<<endl;
 		cout<<" (6) Convert Finite to Boolean : Quadratic Encoding"<<endl;
+		cout<<" (7) Convert Finite to Binary Format"<<endl;
 		cout<<" (0) Quit"<<endl;
 		cout<<endl;
 		cout<<" Enter Choice now : ";
@@ -98,6 +99,12 @@ void PrintHelp()
 			cout<<"  -clause         : * number of clauses in benchmark problem"<<endl;
 			cout<<"  -file           : * name of the output file"<<endl;
 			cout<<"  -time           : amount of time allowed for solver to run"<<endl;
+			cout<<"  -mem            : megabytes the clauses may take, the answer is MEMOUT beyond"<<endl;
+			cout<<"  -threads        : number of threads sharing out the search tree"<<endl;
+			cout<<"  -sym            : break the symmetries of the values and of the variables"<<endl;
+			cout<<"  -subsume        : remove the duplicate and subsumed clauses before the search"<<endl;
+			cout<<"  -batch          : file listing the instances to solve, - for the standard input"<<endl;
+			cout<<"  -socket         : path of a socket the instances to solve are sent to"<<endl;
 			cout<<endl;
 			cout<<" * - required fields"<<endl<<endl;
 			break;
@@ -115,6 +122,12 @@ void PrintHelp()
 			cout<<"  -clause         : * number of clauses in benchmark problem"<<endl;
 			cout<<"  -file           : * name of the output file"<<endl;
 			cout<<"  -time           : amount of time allowed for solver to run"<<endl;
+			cout<<"  -mem            : megabytes the clauses may take, the answer is MEMOUT beyond"<<endl;
+			cout<<"  -sym            : break the symmetries of the values and of the variables"<<endl;
+			cout<<"  -subsume        : remove the duplicate and subsumed clauses before the search"<<endl;
+			cout<<"  -subsumelearned : remove the subsumed learned clauses at the restarts"<<endl;
+			cout<<"  -batch          : file listing the instances to solve, - for the standard input"<<endl;
+			cout<<"  -socket         : path of a socket the instances to solve are sent to"<<endl;
 			cout<<endl;
 			cout<<" * - required fields"<<endl<<endl;
 			break;
@@ -165,6 +178,21 @@ void PrintHelp()
 			break;
 		}
 
+		case 7:
+		{
+			cout<<"**** Convert Finite Domain to Binary Format ****"<<endl;
+			cout<<"**** Use the following format to run the program ****"<<endl;
+			cout<<"% exe -f2bin -file <string> -model <string>"<<endl;
+			cout<<"where : "<<endl;
+			cout<<" exe             : * name of executable"<<endl;
+			cout<<" -f2bin          : * option stating to convert file "<<endl;
+			cout<<" -file           : * name of the finite file "<<endl;
+			cout<<" -model          : * name of the binary file "<<endl;
+			cout<<endl;
+			cout<<" * - required fields"<<endl<<endl;
+			break;
+		}
+
 		default:
 		{
 			break;
@@ -194,11 +222,28 @@ void ParseCommandLine(CommandLine * cline, int argc, char ** argv)
 	cline->FILE = NULL;
 	cline->MODEL_FILE = NULL;
 	cline->TIME = 3600; //1 hour = 60mins * 60secs
+	cline->MEM = 0;
 	cline -> RESTARTS = 0;
+	cline -> LUBY = 0;
+	cline -> GLUCOSE = false;
 	cline->MODEL = true;
 	cline -> WATCH = false;
 	cline -> CMV = false;
 	cline -> VSIDS = false;
+	cline -> EVSIDS = false;
+	cline -> PHASE = false;
+	cline -> SYM = false;
+	cline -> SUBSUME = false;
+	cline -> SUBSUMELEARNED = false;
+	cline -> PORTFOLIO = 0;
+	cline -> SHARESIZE = 8;
+	cline -> SHARELBD = 2;
+	cline -> THREADS = 0;
+	cline -> CUBEDEPTH = 0;
+	cline -> CUBEIN = NULL;
+	cline -> CUBEOUT = NULL;
+	cline -> BATCH = NULL;
+	cline -> SOCKET = NULL;
 	cline -> LOG = false;
 
 
@@ -284,6 +329,20 @@ void ParseCommandLine(CommandLine * cline, int argc, char ** argv)
 			}
 		}
 
+		//If option is for converting finite domain to the binary format
+		else if(!strcmp(argv[1], "-f2bin"))
+		{
+			for(current = 2; current < argc; current++)
+			{
+				if(!strcmp(argv[current], "-file"))
+					cline->FILE = argv[++current];
+				else if(!strcmp(argv[current], "-model"))
+					cline->MODEL_FILE = argv[++current];
+				else
+					;
+			}
+		}
+
 		//If option is for solving a domain problem : Chronological Backtracking
 		else if(!strcmp(argv[1],"-solvech"))
 		{
@@ -303,6 +362,18 @@ void ParseCommandLine(CommandLine * cline, int argc, char ** argv)
 					cline->MODEL_FILE = argv[++current];
 				else if(!strcmp(argv[current], "-time"))
 					cline->TIME = atoi(argv[++current]);
+				else if(!strcmp(argv[current], "-mem"))
+					cline->MEM = atoi(argv[++current]);
+				else if(!strcmp(argv[current], "-threads"))
+					cline -> THREADS = atoi(argv[++current]);
+				else if(!strcmp(argv[current], "-sym"))
+					cline -> SYM = true;
+				else if(!strcmp(argv[current], "-subsume"))
+					cline -> SUBSUME = true;
+				else if(!strcmp(argv[current], "-batch"))
+					cline -> BATCH = argv[++current];
+				else if(!strcmp(argv[current], "-socket"))
+					cline -> SOCKET = argv[++current];
 				else
 					;
 			}
@@ -316,6 +387,10 @@ void ParseCommandLine(CommandLine * cline, int argc, char ** argv)
 			{
 				if (!strcmp(argv[current], "-restart"))
 					cline->RESTARTS = atoi(argv[++current]);
+				else if(!strcmp(argv[current], "-luby"))
+					cline -> LUBY = atoi(argv[++current]);
+				else if(!strcmp(argv[current], "-glucose"))
+					cline -> GLUCOSE = true;
 				else if(!strcmp(argv[current], "-verbose"))
 					cline->LOG = true;
 				else if(!strcmp(argv[current], "-cmv"))
@@ -324,6 +399,34 @@ void ParseCommandLine(CommandLine * cline, int argc, char ** argv)
 					cline -> WATCH = true;
 				else if(!strcmp(argv[current], "-vsids"))
 					cline -> VSIDS = true;
+				else if(!strcmp(argv[current], "-evsids"))
+					cline -> EVSIDS = true;
+				else if(!strcmp(argv[current], "-phase"))
+					cline -> PHASE = true;
+				else if(!strcmp(argv[current], "-sym"))
+					cline -> SYM = true;
+				else if(!strcmp(argv[current], "-subsume"))
+					cline -> SUBSUME = true;
+				else if(!strcmp(argv[current], "-subsumelearned"))
+					cline -> SUBSUMELEARNED = true;
+				else if(!strcmp(argv[current], "-portfolio"))
+					cline -> PORTFOLIO = atoi(argv[++current]);
+				else if(!strcmp(argv[current], "-sharesize"))
+					cline -> SHARESIZE = atoi(argv[++current]);
+				else if(!strcmp(argv[current], "-sharelbd"))
+					cline -> SHARELBD = atoi(argv[++current]);
+				else if(!strcmp(argv[current], "-threads"))
+					cline -> THREADS = atoi(argv[++current]);
+				else if(!strcmp(argv[current], "-cube"))
+					cline -> CUBEDEPTH = atoi(argv[++current]);
+				else if(!strcmp(argv[current], "-cubein"))
+					cline -> CUBEIN = argv[++current];
+				else if(!strcmp(argv[current], "-cubeout"))
+					cline -> CUBEOUT = argv[++current];
+				else if(!strcmp(argv[current], "-batch"))
+					cline -> BATCH = argv[++current];
+				else if(!strcmp(argv[current], "-socket"))
+					cline -> SOCKET = argv[++current];
 				else if(!strcmp(argv[current], "-model"))
 					cline->MODEL = true;
 				else if(!strcmp(argv[current], "-var"))
@@ -340,6 +443,8 @@ void ParseCommandLine(CommandLine * cline, int argc, char ** argv)
 					cline->MODEL_FILE = argv[++current];
 				else if(!strcmp(argv[current], "-time"))
 					cline->TIME = atoi(argv[++current]);
+				else if(!strcmp(argv[current], "-mem"))
+					cline->MEM = atoi(argv[++current]);
 				else
 					;
 			}
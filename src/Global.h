@@ -57,12 +57,48 @@ struct CommandLine
   char * MODEL_FILE;
   //Time limit
   int TIME;
+  //Memory limit of the clauses, in megabytes, 0 for no limit
+  int MEM;
   // Number of backtracks at which the search is started from the level 0
   int RESTARTS;
+  // Unit of the luby restarts, in backtracks
+  int LUBY;
+  // For the glucose restarts, driven by the levels of the learned clauses
+  bool GLUCOSE;
   // For the watched literals algo from Sellmann and Jain 2010
   bool CMV;
   //vsids option
   bool VSIDS;
+  //exponential vsids option
+  bool EVSIDS;
+  //phase saving option
+  bool PHASE;
+  //Symmetry breaking option: clauses keeping one of the symmetric
+  //assignments are added before the search
+  bool SYM;
+  //Subsumption options: the clauses of the input that repeat or are
+  //subsumed by another one are removed before the search, the learned
+  //ones at the restarts
+  bool SUBSUME;
+  bool SUBSUMELEARNED;
+  //Number of searches run at once by the portfolio, 0 for a single search
+  int PORTFOLIO;
+  //The portfolio shares the learned clauses of at most this many atoms,
+  //or over at most this many levels
+  int SHARESIZE;
+  int SHARELBD;
+  //Number of threads of the parallel searches, 0 for one per core
+  int THREADS;
+  //Cube and conquer: depth of the lookahead splitting, the file the
+  //cubes are read from instead, the file the cubes are written to
+  //instead of being solved
+  int CUBEDEPTH;
+  char * CUBEIN;
+  char * CUBEOUT;
+  //Batch mode: the file listing the instances to solve, - for the
+  //standard input, or the socket the instances are sent to
+  char * BATCH;
+  char * SOCKET;
 };
 
 //Global Declaration - Functions
@@ -94,10 +130,17 @@ void LinearEncode(CommandLine * cline);
 //QuadraticEncode
 //This function converts a finite domain file into a boolean domain format
 void QuadraticEncode(CommandLine * cline);
+//Finite2Binary
+//This function converts a finite domain file into the binary format
+void Finite2Binary(CommandLine * cline);
 //SolveFinite
 //This function is called to solve the finite domain problem
 //passed as the argument to the solver
 void SolveFinite(CommandLine * cline, string type);
+//SolveBatch
+//This function solves the instances of a batch list or of a socket in
+//one process and answers each one with a result line
+void SolveBatch(CommandLine * cline, string type);
 //logging
 void Log (char *message);    // logs a message to sdout
 void LogErr (char *message); // logs a message; execution is interrupted
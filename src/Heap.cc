@@ -0,0 +1,129 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Heap.cc
+//**************************************************************
+
+//Including Libraries and Header Files
+#include "Heap.h"
+using namespace std;
+//**************************************************************
+//Start of Code
+
+//Activity above which all activities are scaled down
+#define HEAPRESCALE 1e100
+
+//Zero argument constructor
+AtomHeap::AtomHeap()
+{
+  INCREMENT = 1.0;
+  DECAY = 0.95;
+}
+
+//init
+void AtomHeap::init(int size)
+{
+  ACTIVITY.assign(size, 0.0);
+  POS.assign(size, -1);
+  HEAP.clear();
+  HEAP.reserve(size);
+}
+
+//grow
+void AtomHeap::grow(int size)
+{
+  ACTIVITY.resize(size, 0.0);
+  POS.resize(size, -1);
+}
+
+//insert
+void AtomHeap::insert(int atom)
+{
+  if(POS[atom] >= 0)
+    return;
+  POS[atom] = HEAP.size();
+  HEAP.push_back(atom);
+  percolateUp(POS[atom]);
+}
+
+//removeMax
+int AtomHeap::removeMax()
+{
+  int top = HEAP[0];
+  HEAP[0] = HEAP.back();
+  POS[HEAP[0]] = 0;
+  POS[top] = -1;
+  HEAP.pop_back();
+  if(HEAP.size() > 1)
+    percolateDown(0);
+  return top;
+}
+
+//bump
+void AtomHeap::bump(int atom)
+{
+  ACTIVITY[atom] += INCREMENT;
+  if(ACTIVITY[atom] > HEAPRESCALE)
+    rescale();
+  //the activity only grew, so the atom can only move up
+  if(POS[atom] >= 0)
+    percolateUp(POS[atom]);
+}
+
+//decay
+void AtomHeap::decay()
+{
+  INCREMENT /= DECAY;
+  if(INCREMENT > HEAPRESCALE)
+    rescale();
+}
+
+//rescale
+void AtomHeap::rescale()
+{
+  //the same factor for every atom keeps the heap order
+  for(unsigned int i=0; i<ACTIVITY.size(); i++)
+    ACTIVITY[i] /= HEAPRESCALE;
+  INCREMENT /= HEAPRESCALE;
+}
+
+//percolateUp
+void AtomHeap::percolateUp(int i)
+{
+  int atom = HEAP[i];
+  while(i > 0)
+    {
+      int parent = (i - 1) / 2;
+      if(ACTIVITY[HEAP[parent]] >= ACTIVITY[atom])
+	break;
+      HEAP[i] = HEAP[parent];
+      POS[HEAP[i]] = i;
+      i = parent;
+    }
+  HEAP[i] = atom;
+  POS[atom] = i;
+}
+
+//percolateDown
+void AtomHeap::percolateDown(int i)
+{
+  int atom = HEAP[i];
+  int size = HEAP.size();
+  while(2 * i + 1 < size)
+    {
+      int child = 2 * i + 1;
+      if(child + 1 < size && ACTIVITY[HEAP[child + 1]] > ACTIVITY[HEAP[child]])
+	child++;
+      if(ACTIVITY[HEAP[child]] <= ACTIVITY[atom])
+	break;
+      HEAP[i] = HEAP[child];
+      POS[HEAP[i]] = i;
+      i = child;
+    }
+  HEAP[i] = atom;
+  POS[atom] = i;
+}
+
+// End of Code
+//**************************************************************
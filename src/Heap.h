@@ -0,0 +1,72 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Heap.h
+// Description : Contains code for the activity heap used by the
+// exponential vsids heuristic. The elements are the atoms of the
+// formula numbered from 0, the atom with the highest activity is
+// at the top.
+//**************************************************************
+#ifndef HEAP_H
+#define HEAP_H
+
+//Including Libraries and Header files
+#include <vector>
+
+using namespace std;
+//**************************************************************
+// AtomHeap
+// This class is a binary max-heap of atom numbers ordered by their
+// activity. Bumping adds an increment that grows after every
+// conflict, so older bumps count less without touching every
+// activity; all activities are scaled down only when they get
+// too large.
+//
+// Start of Code
+class AtomHeap
+{
+  //public variables and functions
+public:
+  //ACTIVITY = activity of each atom
+  //INCREMENT = amount added to the activity of a bumped atom
+  //DECAY = factor by which INCREMENT is divided after a conflict
+  vector <double> ACTIVITY;
+  double INCREMENT;
+  double DECAY;
+  //Zero argument constructor
+  AtomHeap();
+  //init : makes room for size atoms, all with zero activity and none in the heap
+  void init(int size);
+  //grow : makes room for atoms up to size, the new ones with zero activity
+  //       and not in the heap
+  void grow(int size);
+  //empty : returns true if no atom is in the heap
+  bool empty() const { return HEAP.empty(); }
+  //contains : returns true if the atom is in the heap
+  bool contains(int atom) const { return POS[atom] >= 0; }
+  //insert : puts the atom in the heap, if it is not already there
+  void insert(int atom);
+  //removeMax : removes and returns the atom with the highest activity
+  int removeMax();
+  //bump : increases the activity of the atom
+  void bump(int atom);
+  //decay : makes the future bumps count more than the past ones
+  void decay();
+  //private variables and functions
+private:
+  //HEAP = the atoms in heap order
+  //POS = position of each atom in HEAP, -1 if not in the heap
+  vector <int> HEAP;
+  vector <int> POS;
+  //rescale : scales down all activities and the increment
+  void rescale();
+  //percolateUp : moves the atom at position i up to its place
+  void percolateUp(int i);
+  //percolateDown : moves the atom at position i down to its place
+  void percolateDown(int i);
+};
+// End of Code
+//
+#endif
+//**************************************************************
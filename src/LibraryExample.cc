@@ -0,0 +1,83 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : LibraryExample.cc
+// Description : Example program of the FiniteSolver library API,
+// linked against libmvl.a. It solves a small formula incrementally
+// with the counting and the watched literal engines, checks every
+// answer and exits with 1 if one is wrong.
+//**************************************************************
+//Including Libraries and Header files
+#include <iostream>
+#include <vector>
+
+#include "FiniteSolver.h"
+
+using namespace std;
+//**************************************************************
+//Start of Code
+
+//number of checks that did not hold
+static int failures = 0;
+
+//check : reports a check and counts it if it does not hold
+static void check(bool holds, const char * what)
+{
+  cout << (holds ? "ok     " : "FAILED ") << what << endl;
+  if(!holds)
+    failures++;
+}
+
+//example : runs the checks on a solver, with the watched literal
+//engine if watch is true
+static void example(bool watch)
+{
+  cout << (watch ? "Watched literal engine" : "Counting engine") << endl;
+  FiniteSolver solver;
+  solver.formula()->WATCH = watch;
+
+  //wrong arguments are answered, not fatal
+  check(solver.addVariable(0) == -1, "a domain of size 0 is refused");
+  int x = solver.addVariable(3);
+  int y = solver.addVariable(3);
+  check(!solver.addClause({makeLit(x, true, 3)}), "an atom outside of the domain is refused");
+  check(!solver.addClause({makeLit(y + 1, true, 0)}), "an atom over a variable not added is refused");
+  check(solver.solve({makeLit(y + 1, true, 0)}) == INPUTERROR, "an assumption over a variable not added is refused");
+  check(solver.value(y + 1) == -1, "value of a variable not added is -1");
+
+  //add, solve, add, solve
+  check(solver.addClause({makeLit(x, false, 0), makeLit(y, true, 1)}), "x!=0 y=1 is added");
+  check(solver.solve() == 0, "x!=0 y=1 is sat");
+  check(solver.value(x) != 0 || solver.value(y) == 1, "the model satisfies x!=0 y=1");
+  int z = solver.addVariable(2);
+  solver.addClause({makeLit(y, false, 1)});
+  solver.addClause({makeLit(x, false, 1), makeLit(z, true, 1)});
+  check(solver.solve() == 0, "after y!=1, z in {0,1} and x!=1 z=1 it is still sat");
+  check(solver.value(x) == 1 || solver.value(x) == 2, "the model has x=1 or x=2");
+  check(solver.value(y) != 1, "the model has y!=1");
+  check(solver.value(x) != 1 || solver.value(z) == 1, "the model satisfies x!=1 z=1");
+
+  //an assumption falsified by the clauses, then a search without it
+  check(solver.solve({makeLit(x, true, 0)}) == 2, "assuming x=0 is unsat");
+  check(solver.failed(), "the unsat answer is due to the assumption");
+  check(solver.solve({makeLit(z, true, 0)}) == 0, "assuming z=0 is sat");
+  check(!solver.failed() && solver.value(z) == 0 && solver.value(x) == 2, "the model has z=0 and x=2");
+
+  //a clause making the formula unsat whatever is assumed
+  solver.addClause({makeLit(x, false, 2)});
+  solver.addClause({makeLit(z, false, 1)});
+  check(solver.solve() == 2 && !solver.failed(), "after x!=2 and z!=1 it is unsat");
+  cout << endl;
+}
+
+int main()
+{
+  example(false);
+  example(true);
+  cout << (failures ? "Some checks FAILED" : "All checks hold") << endl;
+  return failures ? 1 : 0;
+}
+
+// End of Code
+//**************************************************************
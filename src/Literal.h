@@ -21,6 +21,31 @@
 
 using namespace std;
 //**************************************************************
+// LIT
+// A literal packed into a single integer, as stored in the clauses:
+// bit 0 is set for = and clear for !, the next LITVALBITS bits hold
+// the domain value and the remaining high bits the variable. Variable
+// 0 is never a real variable, so NOLIT (0) stands for no literal
+typedef unsigned int LIT;
+#define LITVALBITS 12
+#define LITMAXVAR ((1 << (31 - LITVALBITS)) - 1)
+#define LITMAXDOMAIN (1 << LITVALBITS)
+const LIT NOLIT = 0;
+
+//makeLit : packs var = val (equal true) or var ! val (equal false)
+inline LIT makeLit(int var, bool equal, int val)
+{ return ((LIT) var << (LITVALBITS + 1)) | ((LIT) val << 1) | (equal ? 1 : 0); }
+//litVar, litVal, litEqual : unpack the fields of a literal
+inline int litVar(LIT lit) { return lit >> (LITVALBITS + 1); }
+inline int litVal(LIT lit) { return (lit >> 1) & (LITMAXDOMAIN - 1); }
+inline bool litEqual(LIT lit) { return lit & 1; }
+//printLit : prints the literal the same way as Literal::Print
+inline void printLit(LIT lit)
+{
+  cout<<litVar(lit);
+  if(litEqual(lit)) cout<<"="<<litVal(lit)<<endl; else cout<<"!="<<litVal(lit)<<endl;
+}
+
 // Literal
 // This class represents the Literal object for the solver which
 // stores the variable name, and its value for the benchmark. It
@@ -25,17 +25,20 @@ using namespace std;
 //Start of Code
 int main(int argc, char ** argv)
 {
-  //Start Solver Time
-  cout<<endl<<"************************************************************************"<<endl;
-
-  cout<<endl<<"Finite Domain Sat Solver"<<endl;
-
-  cout<<endl<<"************************************************************************"<<endl;
-
   //Parse commandline info
   CommandLine * clineinfo = new CommandLine;
   ParseCommandLine(clineinfo, argc, argv);
 
+  //Start Solver Time, the batch mode answers with its result lines only
+  if(!clineinfo->BATCH && !clineinfo->SOCKET)
+    {
+      cout<<endl<<"************************************************************************"<<endl;
+
+      cout<<endl<<"Finite Domain Sat Solver"<<endl;
+
+      cout<<endl<<"************************************************************************"<<endl;
+    }
+
   //Check what option is selected and call appropriate function
   if(argc <= 1)
     {
@@ -77,6 +80,12 @@ int main(int argc, char ** argv)
       QuadraticEncode(clineinfo);
     }
 
+  else if(!strcmp(argv[1], "-f2bin"))
+    {
+      //Call Finite2Binary
+      Finite2Binary(clineinfo);
+    }
+
   else if(!strcmp(argv[1], "-solvech"))
     {
         SolveFinite(clineinfo, "ch");
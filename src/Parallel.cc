@@ -0,0 +1,135 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Parallel.cc
+//**************************************************************
+
+//Including Libraries and Header Files
+#include "Parallel.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+using namespace std;
+//**************************************************************
+//Start of Code
+
+//PARALLELSEARCH
+//State shared by the threads of the chronological search
+struct PARALLELSEARCH
+{
+  mutex LOCK;
+  condition_variable CHANGED;
+  atomic<bool> STOP;
+  int RUNNING;
+  int WINNER;
+  int LIMIT;
+};
+
+//SolveParallelChrono
+int SolveParallelChrono(Formula * master, CommandLine * cline, int threads,
+			Formula * & winner, string & report)
+{
+  PARALLELSEARCH shared;
+  double start = master->TIME_S;
+  int timelimit = master->TIMELIMIT;
+  shared.STOP = false;
+  shared.RUNNING = threads;
+  shared.WINNER = -1;
+  shared.LIMIT = 0;
+
+  //the whole tree is the first task
+  TaskPool pool(threads);
+  pool.push(0, vector <LIT> ());
+
+  vector <Formula *> formulas(threads, (Formula *) NULL);
+  vector <int> tasks(threads, 0);
+  vector <thread> workers;
+  for(int i = 0; i < threads; i++)
+    {
+      formulas[i] = new Formula(cline);
+      formulas[i]->LOG = false;
+      formulas[i]->WATCH = false;
+      formulas[i]->CMV = false;
+      formulas[i]->EVSIDS = false;
+      formulas[i]->STOP = &shared.STOP;
+      formulas[i]->TASKS = &pool;
+      formulas[i]->SHAREID = i;
+
+      workers.push_back(thread([&, i]()
+	{
+	  Formula * formula = formulas[i];
+	  formula->shareClauses(master);
+	  formula->TIME_S = start;
+
+	  //a task is searched below the path it was given, which the
+	  //search asserts as its assumptions
+	  vector <LIT> task;
+	  int result = 2;
+	  while(pool.take(i, task, shared.STOP))
+	    {
+	      formula->ASSUMPTIONS = task;
+	      result = formula->ChronoBacktrack(0);
+	      tasks[i]++;
+	      if(result != 2)
+		break;
+	      formula->resetSearch();
+	      pool.finish();
+	    }
+
+	  unique_lock <mutex> lock(shared.LOCK);
+	  if(result == 0 && shared.WINNER < 0)
+	    {
+	      shared.WINNER = i;
+	      shared.STOP = true;
+	    }
+	  if(result == 1 || result == MEMOUT)
+	    {
+	      shared.LIMIT = result;
+	      shared.STOP = true;
+	    }
+	  shared.RUNNING--;
+	  shared.CHANGED.notify_all();
+	}));
+    }
+
+  //stop the threads at the time limit
+  {
+    unique_lock <mutex> lock(shared.LOCK);
+    chrono::duration <double> limit(start + timelimit - GetTime());
+    if(!shared.CHANGED.wait_for(lock, limit, [&]() { return shared.WINNER >= 0 || shared.RUNNING == 0; }))
+      {
+	shared.STOP = true;
+	shared.LIMIT = 1;
+      }
+  }
+  for(unsigned int i = 0; i < workers.size(); i++)
+    workers[i].join();
+
+  int result = 2;
+  if(shared.WINNER >= 0)
+    result = 0;
+  else if(shared.LIMIT)
+    result = shared.LIMIT;
+  winner = formulas[shared.WINNER >= 0 ? shared.WINNER : 0];
+
+  //what each thread did
+  char line[256];
+  report = "Thread  Tasks  Donated  Decisions  Backtracks\n";
+  for(int i = 0; i < threads; i++)
+    {
+      snprintf(line, sizeof(line), "%6d %6d %8d %10d %11d%s\n", i, tasks[i], formulas[i]->DONATED,
+	       formulas[i]->DECISIONS, formulas[i]->BACKTRACKS, i == shared.WINNER ? "  (winner)" : "");
+      report += line;
+    }
+  //the other copies are not needed any more
+  for(int i = 0; i < threads; i++)
+    if(formulas[i] != winner)
+      delete formulas[i];
+  winner->TIME_E = GetTime();
+  return result;
+}
+
+// End of Code
+//**************************************************************
@@ -0,0 +1,32 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Parallel.h
+// Description : Contains code for the chronological search on
+// several threads. The threads search copies of the formula and
+// share out the subtrees of the search tree through a TaskPool:
+// a thread gives away its oldest open branch when another one is
+// out of work, and the other one replays the path down to it.
+//**************************************************************
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+//Including Libraries and Header files
+#include <string>
+
+#include "Global.h"
+#include "Formula.h"
+
+using namespace std;
+//**************************************************************
+//SolveParallelChrono
+//Searches the tree of the chronological search of master on threads
+//threads. Returns 0 if one of them finds a model, 2 once the whole
+//tree is searched, 1 on timeout; sets winner to the formula to report
+//on and report to what every thread did. The copies are deleted, but
+//winner, which the caller deletes before master
+int SolveParallelChrono(Formula * master, CommandLine * cline, int threads,
+			Formula * & winner, string & report);
+#endif
+//**************************************************************
@@ -0,0 +1,203 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Portfolio.cc
+//**************************************************************
+
+//Including Libraries and Header Files
+#include "Portfolio.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+using namespace std;
+//**************************************************************
+//Start of Code
+
+//PORTFOLIOCONFIG
+//Options of a search of the portfolio besides the one of the command line
+struct PORTFOLIOCONFIG
+{
+  const char * NAME;
+  bool WATCH;
+  bool VSIDS;
+  bool EVSIDS;
+  bool PHASE;
+  int POLICY;
+  int UNIT;
+};
+
+//Number of clauses each search can share before it overwrites the oldest
+#define SHARECAPACITY 4096
+
+//The configurations are used in turn, and again with another seed
+//once all are taken
+static const PORTFOLIOCONFIG CONFIGS[] = {
+  { "evsids luby phase", false, false, true, true, RESTARTLUBY, 100 },
+  { "wl evsids glucose", true, false, true, false, RESTARTGLUCOSE, 0 },
+  { "evsids glucose phase", false, false, true, true, RESTARTGLUCOSE, 0 },
+  { "wl evsids luby phase", true, false, true, true, RESTARTLUBY, 100 },
+  { "vsids restart", false, true, false, false, RESTARTFIXED, 1000 },
+  { "evsids luby", false, false, true, false, RESTARTLUBY, 512 },
+  { "wl counts", true, false, false, false, RESTARTNONE, 0 },
+};
+#define NUMCONFIGS (int) (sizeof(CONFIGS) / sizeof(CONFIGS[0]))
+
+//PORTFOLIO
+//State shared by the searches of the portfolio
+struct PORTFOLIO
+{
+  mutex LOCK;
+  condition_variable CHANGED;
+  atomic<bool> STOP;
+  int READY;
+  int RUNNING;
+  int WINNER;
+  int RESULT;
+  int FAILED;
+  bool TIMEDOUT;
+};
+
+//search
+//Runs the search of formula, the engine follows its options
+static int search(Formula * formula)
+{
+  if(formula->CMV)
+    return formula->tempWatchedLiterals();
+  if(formula->WATCH)
+    return formula->WatchedLiterals();
+  return formula->NonChronoBacktrack();
+}
+
+//SolvePortfolio
+int SolvePortfolio(Formula * master, CommandLine * cline, int threads,
+		   Formula * & winner, string & report)
+{
+  PORTFOLIO shared;
+  double start = master->TIME_S;
+  int timelimit = master->TIMELIMIT;
+  shared.STOP = false;
+  shared.READY = 1;
+  shared.RUNNING = threads;
+  shared.WINNER = -1;
+  shared.RESULT = 1;
+  shared.FAILED = 1;
+  shared.TIMEDOUT = false;
+
+  ClauseExchange exchange(threads, SHARECAPACITY);
+
+  vector <Formula *> formulas(threads, (Formula *) NULL);
+  vector <string> names(threads);
+  formulas[0] = master;
+  names[0] = "command line";
+  master->STOP = &shared.STOP;
+  master->LOG = false;
+
+  vector <thread> workers;
+  for(int i = 0; i < threads; i++)
+    {
+      if(i > 0)
+	{
+	  const PORTFOLIOCONFIG & config = CONFIGS[(i - 1) % NUMCONFIGS];
+	  formulas[i] = new Formula(cline);
+	  formulas[i]->LOG = false;
+	  formulas[i]->WATCH = config.WATCH;
+	  formulas[i]->CMV = false;
+	  formulas[i]->VSIDS = config.VSIDS;
+	  formulas[i]->EVSIDS = config.EVSIDS;
+	  formulas[i]->PHASE = config.PHASE;
+	  formulas[i]->SEED = (i - 1) / NUMCONFIGS;
+	  formulas[i]->RESTARTER.init(config.POLICY, config.UNIT);
+	  formulas[i]->STOP = &shared.STOP;
+	  names[i] = config.NAME;
+	  if(formulas[i]->SEED)
+	    names[i] += " seed " + to_string(formulas[i]->SEED);
+	}
+
+      formulas[i]->EXCHANGE = &exchange;
+      formulas[i]->SHAREID = i;
+      formulas[i]->SHARESIZE = cline->SHARESIZE;
+      formulas[i]->SHARELBD = cline->SHARELBD;
+
+      workers.push_back(thread([&, i]()
+	{
+	  Formula * formula = formulas[i];
+	  if(i > 0)
+	    {
+	      //the copies are built while master waits, it must not
+	      //learn clauses while they read its input clauses
+	      formula->shareClauses(master);
+	      unique_lock <mutex> lock(shared.LOCK);
+	      shared.READY++;
+	      shared.CHANGED.notify_all();
+	    }
+	  else
+	    {
+	      unique_lock <mutex> lock(shared.LOCK);
+	      shared.CHANGED.wait(lock, [&]() { return shared.READY == threads; });
+	    }
+
+	  formula->TIME_S = start;
+	  int result = search(formula);
+
+	  //the first search with an answer wins and stops the others, a
+	  //search that ran out of time or memory only retires
+	  unique_lock <mutex> lock(shared.LOCK);
+	  if((result == 0 || result == 2) && shared.WINNER < 0)
+	    {
+	      shared.WINNER = i;
+	      shared.RESULT = result;
+	      shared.STOP = true;
+	    }
+	  else if(result == 1)
+	    shared.TIMEDOUT = true;
+	  else if(result != 0 && result != 2)
+	    shared.FAILED = result;
+	  shared.RUNNING--;
+	  shared.CHANGED.notify_all();
+	}));
+    }
+
+  //stop the searches at the time limit, all at once rather than each
+  //at its next reading of the clock
+  {
+    unique_lock <mutex> lock(shared.LOCK);
+    chrono::duration <double> limit(start + timelimit - GetTime());
+    if(!shared.CHANGED.wait_for(lock, limit, [&]() { return shared.WINNER >= 0 || shared.RUNNING == 0; }))
+      {
+	shared.STOP = true;
+	shared.TIMEDOUT = true;
+      }
+  }
+  for(unsigned int i = 0; i < workers.size(); i++)
+    workers[i].join();
+
+  //without an answer, a failure is reported only if no search was
+  //still going when the time ran out
+  if(shared.WINNER < 0 && !shared.TIMEDOUT)
+    shared.RESULT = shared.FAILED;
+  int best = shared.WINNER >= 0 ? shared.WINNER : 0;
+  winner = formulas[best];
+
+  //what each search did, to tune the sharing
+  char line[256];
+  report = "Portfolio   : " + names[best] + "\n\n";
+  report += "Search  Decisions  Exported  Imported  Used  Configuration\n";
+  for(int i = 0; i < threads; i++)
+    {
+      snprintf(line, sizeof(line), "%6d %10d %9d %9d %5d  %s%s\n", i, formulas[i]->DECISIONS,
+	       formulas[i]->EXPORTED, formulas[i]->IMPORTED, formulas[i]->USEDIMPORTS,
+	       names[i].c_str(), i == shared.WINNER ? " (winner)" : "");
+      report += line;
+    }
+  //the other copies are not needed any more, master is the caller's
+  for(int i = 1; i < threads; i++)
+    if(formulas[i] != winner)
+      delete formulas[i];
+  winner->TIME_E = GetTime();
+  return shared.RESULT;
+}
+
+// End of Code
+//**************************************************************
@@ -0,0 +1,34 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Portfolio.h
+// Description : Contains code for solving one formula with several
+// differently configured searches at once, one per thread. The
+// first search that finds an answer stops the others.
+//**************************************************************
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+//Including Libraries and Header files
+#include <string>
+
+#include "Global.h"
+#include "Formula.h"
+
+using namespace std;
+//**************************************************************
+//SolvePortfolio
+//Solves master on threads searches: the first one is master itself
+//with the options of the command line, the others search copies of
+//it that share its input clauses and differ in engine, heuristic,
+//restart policy and seed. They exchange their short learned clauses.
+//Returns the result of the first search that found an answer, 1 on
+//timeout, or the failure of the searches if all of them ran out of
+//memory without an answer, sets winner to its formula and report to its configuration
+//and what every search did. The other copies are deleted, so winner
+//is master or a copy the caller deletes before master
+int SolvePortfolio(Formula * master, CommandLine * cline, int threads,
+		   Formula * & winner, string & report);
+#endif
+//**************************************************************
@@ -0,0 +1,112 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Restart.cc
+//**************************************************************
+
+//Including Libraries and Header Files
+#include "Restart.h"
+using namespace std;
+//**************************************************************
+//Start of Code
+
+//Number of latest conflicts in the moving average of the glucose policy
+#define GLUCOSEWINDOW 50
+//The glucose policy restarts when the moving average times this factor
+//is above the average of all conflicts
+#define GLUCOSEFACTOR 0.8
+
+//Zero argument constructor
+RestartScheduler::RestartScheduler()
+{
+  init(RESTARTNONE, 0);
+}
+
+//init
+void RestartScheduler::init(int policy, int unit)
+{
+  POLICY = policy;
+  UNIT = unit;
+  LUBYINDEX = 0;
+  TOTALSUM = 0;
+  TOTALCOUNT = 0;
+  RECENT.assign(POLICY == RESTARTGLUCOSE ? GLUCOSEWINDOW : 0, 0);
+  restart();
+}
+
+//conflict
+void RestartScheduler::conflict(int lbd)
+{
+  CONFLICTS++;
+  if(POLICY != RESTARTGLUCOSE)
+    return;
+
+  TOTALSUM += lbd;
+  TOTALCOUNT++;
+
+  //the oldest value leaves the window once it is full
+  if(RECENTSIZE == GLUCOSEWINDOW)
+    RECENTSUM -= RECENT[RECENTPOS];
+  else
+    RECENTSIZE++;
+  RECENT[RECENTPOS] = lbd;
+  RECENTSUM += lbd;
+  RECENTPOS = (RECENTPOS + 1) % GLUCOSEWINDOW;
+}
+
+//due
+bool RestartScheduler::due()
+{
+  switch(POLICY)
+    {
+    case RESTARTFIXED:
+    case RESTARTLUBY:
+      return CONFLICTS >= LIMIT;
+    case RESTARTGLUCOSE:
+      //the latest clauses are much worse than usual
+      return RECENTSIZE == GLUCOSEWINDOW
+	&& (double) RECENTSUM / RECENTSIZE * GLUCOSEFACTOR > TOTALSUM / TOTALCOUNT;
+    default:
+      return false;
+    }
+}
+
+//restart
+void RestartScheduler::restart()
+{
+  CONFLICTS = 0;
+  RECENTSIZE = 0;
+  RECENTPOS = 0;
+  RECENTSUM = 0;
+  if(POLICY == RESTARTFIXED)
+    LIMIT = UNIT;
+  else if(POLICY == RESTARTLUBY)
+    LIMIT = UNIT * luby(LUBYINDEX++);
+}
+
+//luby
+int RestartScheduler::luby(int i)
+{
+  //find the finite subsequence that contains index i, and its size
+  int size = 1;
+  int seq = 0;
+  while(size < i + 1)
+    {
+      seq++;
+      size = 2 * size + 1;
+    }
+
+  //descend into the half of the subsequence that contains i
+  while(size - 1 != i)
+    {
+      size = (size - 1) / 2;
+      seq--;
+      i = i % size;
+    }
+
+  return 1 << seq;
+}
+
+// End of Code
+//**************************************************************
@@ -0,0 +1,77 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Restart.h
+// Description : Contains code for deciding when the search
+// restarts from the level 0. The policies are a fixed number of
+// backtracks, the luby sequence, and the glucose policy driven
+// by the levels of the learned clauses.
+//**************************************************************
+#ifndef RESTART_H
+#define RESTART_H
+
+//Including Libraries and Header files
+#include <vector>
+
+using namespace std;
+
+//Restart policies
+#define RESTARTNONE 0
+#define RESTARTFIXED 1
+#define RESTARTLUBY 2
+#define RESTARTGLUCOSE 3
+
+//**************************************************************
+// RestartScheduler
+// This class is told about every conflict of the search, with the
+// number of levels (lbd) of the clause learned from it, and says
+// when the next restart is due.
+//
+// Start of Code
+class RestartScheduler
+{
+  //public variables and functions
+public:
+  //POLICY = one of the restart policies above
+  //UNIT = backtracks between restarts for the fixed policy, unit of the
+  //       luby sequence
+  int POLICY;
+  int UNIT;
+  //Zero argument constructor
+  RestartScheduler();
+  //init : selects the policy, the unit is not used by the glucose policy
+  void init(int policy, int unit);
+  //conflict : records a conflict and the lbd of the clause learned from it
+  void conflict(int lbd);
+  //due : returns true if the search should restart now
+  bool due();
+  //restart : starts counting towards the next restart
+  void restart();
+  //private variables and functions
+private:
+  //CONFLICTS = conflicts since the last restart
+  //LIMIT = conflicts at which the next restart is due, fixed and luby policies
+  //LUBYINDEX = position in the luby sequence
+  //RECENT = lbd of the latest conflicts, a circular buffer, glucose policy
+  //RECENTSIZE = number of lbd values in RECENT
+  //RECENTPOS = where the next lbd value goes in RECENT
+  //RECENTSUM = sum of the lbd values in RECENT
+  //TOTALSUM = sum of the lbd values of all conflicts
+  //TOTALCOUNT = number of all conflicts
+  int CONFLICTS;
+  int LIMIT;
+  int LUBYINDEX;
+  vector <int> RECENT;
+  int RECENTSIZE;
+  int RECENTPOS;
+  long RECENTSUM;
+  double TOTALSUM;
+  long TOTALCOUNT;
+  //luby : returns the i-th element of the luby sequence 1 1 2 1 1 2 4 ...
+  static int luby(int i);
+};
+// End of Code
+//
+#endif
+//**************************************************************
@@ -0,0 +1,94 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Share.cc
+//**************************************************************
+
+//Including Libraries and Header Files
+#include "Share.h"
+using namespace std;
+//**************************************************************
+//Start of Code
+
+//Two argument constructor
+ClauseExchange::ClauseExchange(int threads, int capacity)
+{
+  THREADS = threads;
+  CAPACITY = capacity;
+  SLOTS = new SHARESLOT[threads * capacity];
+  for(int i = 0; i < threads * capacity; i++)
+    SLOTS[i].SEQ.store(0, memory_order_relaxed);
+  HEAD = new atomic<unsigned long>[threads];
+  for(int i = 0; i < threads; i++)
+    HEAD[i].store(0, memory_order_relaxed);
+  CURSOR.assign(threads * threads, 0);
+}
+
+//Destructor
+ClauseExchange::~ClauseExchange()
+{
+  delete [] SLOTS;
+  delete [] HEAD;
+}
+
+//publish
+void ClauseExchange::publish(int thread, const LIT * atoms, int size, int lbd)
+{
+  unsigned long i = HEAD[thread].load(memory_order_relaxed);
+  SHARESLOT & slot = SLOTS[thread * CAPACITY + i % CAPACITY];
+
+  //mark the slot as being written before the clause goes in
+  slot.SEQ.store(2 * i + 1, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  slot.SIZE.store(size, memory_order_relaxed);
+  slot.LBD.store(lbd, memory_order_relaxed);
+  for(int k = 0; k < size; k++)
+    slot.ATOMS[k].store(atoms[k], memory_order_relaxed);
+  slot.SEQ.store(2 * (i + 1), memory_order_release);
+
+  HEAD[thread].store(i + 1, memory_order_release);
+}
+
+//collect
+void ClauseExchange::collect(int thread, vector <LIT> & atoms, vector <int> & sizes, vector <int> & lbds)
+{
+  LIT copy[SHAREMAXSIZE];
+  for(int ring = 0; ring < THREADS; ring++)
+    {
+      if(ring == thread)
+	continue;
+      unsigned long & cursor = CURSOR[thread * THREADS + ring];
+      unsigned long head = HEAD[ring].load(memory_order_acquire);
+
+      //the clauses more than a ring behind are overwritten
+      if(head - cursor > (unsigned long) CAPACITY)
+	cursor = head - CAPACITY;
+
+      for(; cursor < head; cursor++)
+	{
+	  SHARESLOT & slot = SLOTS[ring * CAPACITY + cursor % CAPACITY];
+	  unsigned long seq = slot.SEQ.load(memory_order_acquire);
+	  if(seq != 2 * (cursor + 1))
+	    continue;
+	  int size = slot.SIZE.load(memory_order_relaxed);
+	  int lbd = slot.LBD.load(memory_order_relaxed);
+	  if(size < 0 || size > SHAREMAXSIZE)
+	    continue;
+	  for(int k = 0; k < size; k++)
+	    copy[k] = slot.ATOMS[k].load(memory_order_relaxed);
+
+	  //the writer got to the slot again while it was read
+	  atomic_thread_fence(memory_order_acquire);
+	  if(slot.SEQ.load(memory_order_relaxed) != seq)
+	    continue;
+
+	  atoms.insert(atoms.end(), copy, copy + size);
+	  sizes.push_back(size);
+	  lbds.push_back(lbd);
+	}
+    }
+}
+
+// End of Code
+//**************************************************************
@@ -0,0 +1,75 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Share.h
+// Description : Contains code for exchanging learned clauses
+// between the searches of the portfolio without locks. Every
+// search writes into its own ring of slots and reads the rings of
+// the others; a reader that falls a whole ring behind skips the
+// clauses it missed.
+//**************************************************************
+#ifndef SHARE_H
+#define SHARE_H
+
+//Including Libraries and Header files
+#include <vector>
+#include <atomic>
+
+#include "Literal.h"
+
+using namespace std;
+
+//Largest clause that fits in a slot
+#define SHAREMAXSIZE 32
+
+//**************************************************************
+// SHARESLOT
+// This is a clause in a ring. SEQ is odd while the clause is being
+// written, and 2*(i+1) once the i-th clause of the ring is in it, so
+// a reader can tell whether the clause changed while it was reading
+struct SHARESLOT
+{
+  atomic<unsigned long> SEQ;
+  atomic<int> SIZE;
+  atomic<int> LBD;
+  atomic<LIT> ATOMS[SHAREMAXSIZE];
+};
+
+// ClauseExchange
+// This class holds one ring of clauses for each search. Only the
+// search that owns a ring writes into it, every search keeps its
+// own position in the rings of the others.
+//
+// Start of Code
+class ClauseExchange
+{
+  //public variables and functions
+public:
+  //Two argument constructor : rings of capacity clauses for threads searches
+  ClauseExchange(int threads, int capacity);
+  //Destructor
+  ~ClauseExchange();
+  //publish : adds a clause to the ring of the thread, size at most SHAREMAXSIZE
+  void publish(int thread, const LIT * atoms, int size, int lbd);
+  //collect : appends the clauses of the other threads that the thread has
+  //          not read yet, one after the other in atoms with their sizes and lbd
+  void collect(int thread, vector <LIT> & atoms, vector <int> & sizes, vector <int> & lbds);
+  //private variables and functions
+private:
+  //THREADS = number of rings
+  //CAPACITY = number of slots of each ring
+  //SLOTS = the slots of all the rings, ring after ring
+  //HEAD = number of clauses written so far into each ring
+  //CURSOR = number of clauses of each ring read by each thread, the
+  //         positions of a thread follow each other
+  int THREADS;
+  int CAPACITY;
+  SHARESLOT * SLOTS;
+  atomic<unsigned long> * HEAD;
+  vector <unsigned long> CURSOR;
+};
+// End of Code
+//
+#endif
+//**************************************************************
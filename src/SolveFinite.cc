@@ -8,6 +8,12 @@
 //Including Libraries and Header files
 #include "Global.h"
 #include "Formula.h"
+#include "Portfolio.h"
+#include "Cube.h"
+#include "Parallel.h"
+#include "Batch.h"
+#include "Symmetry.h"
+#include <unistd.h>
 #include <time.h>
 
 using namespace std;
@@ -15,30 +21,20 @@ using namespace std;
 
 //**********************************************************************//
 //Function Definitions
-//SolveFinite: fn to read input and build corresponding objects for solving, calls the cdpll algo
-//This function calls the finite domain solver and tries to find a model for
-//the problem if the problem is satisfiable
-void SolveFinite(CommandLine * cline, string type)
+//Search: runs the algorithm of type and the options of the command line on
+//fobj, which becomes the formula of the parallel search that answered
+static int Search(Formula * & fobj, CommandLine * cline, string type, string & report)
 {
-  //local variable
-  double difftime = 0;
-  double totaltime = 0;
   int result = -1;
-  Formula * fobj;
+  string symmetries;
 
-  //Creating object
-  fobj = new Formula(cline);
-  //Building database
-  fobj->BuildFormula(cline);
-  //Compute Buildtime
-  difftime = fobj->TIME_E - fobj->TIME_S;
-  totaltime += difftime;
-  printf("%s \t%2.4f\t", cline->FILE, fabs(difftime));
-  //reinitialize the TIME_S and TIME_E
-  fobj->TIME_S = GetTime();
-  fobj->TIME_E = GetTime();
-  //call the algorithm
-  // fobj->checkUnit(); // move this check to the algo
+  // the chronological and the cmv engines know clauses only
+  if(type == "ch" || cline -> CMV)
+    fobj->decomposeConstraints();
+
+  // the searches below set the report of their own
+  if(cline -> SYM)
+    BreakSymmetries(fobj, symmetries);
 
   // *** Extended DPLL Algorithm Options
 
@@ -46,31 +42,84 @@ void SolveFinite(CommandLine * cline, string type)
 
  {
       // 1. Chronological Backtracking
-     result = fobj->ChronoBacktrack(0); // The function defined in FDSolver/Formula.cc
+     if ( cline -> THREADS > 1 )
+	     result = SolveParallelChrono ( fobj, cline, cline -> THREADS, fobj, report );
+     else
+	     result = fobj->ChronoBacktrack(0); // The function defined in FDSolver/Formula.cc
     }
 
   // 2. NonChronological Backtracking with Clause learning
  else
     {
-	 if ( cline -> CMV   ) {
+	 // the restart policy of cline is set up by the Formula constructor
+
+	 if ( cline -> CUBEDEPTH > 0 || cline -> CUBEIN ) {
 
-	     	  result = fobj-> tempWatchedLiterals ( cline -> RESTARTS );
+	     	  result = SolveCubes ( fobj, cline, fobj, report );
+	       }
+
+	 else if ( cline -> PORTFOLIO > 1 ) {
+
+	     	  result = SolvePortfolio ( fobj, cline, cline -> PORTFOLIO, fobj, report );
+	       }
+
+	 else if ( cline -> CMV   ) {
+
+	     	  result = fobj-> tempWatchedLiterals ();
 	       }
 
 	 else if ( cline -> WATCH  ) {
 
 
-    	  result = fobj-> WatchedLiterals ( cline -> RESTARTS );
+    	  result = fobj-> WatchedLiterals ();
 
       }
-      else if (cline->RESTARTS != 0) {
-        result = fobj->NonChronoBacktrack(cline->RESTARTS);
-      }
       else  {
 
      result = fobj->NonChronoBacktrack();
       }
     }
+  report = symmetries + report;
+  return result;
+}
+
+//SolveFinite: fn to read input and build corresponding objects for solving, calls the cdpll algo
+//This function calls the finite domain solver and tries to find a model for
+//the problem if the problem is satisfiable
+void SolveFinite(CommandLine * cline, string type)
+{
+  //local variable
+  double difftime = 0;
+  double totaltime = 0;
+  int result = -1;
+  Formula * fobj;
+  string report;
+
+  if(cline->BATCH || cline->SOCKET)
+    {
+      SolveBatch(cline, type);
+      return;
+    }
+
+  //Creating object
+  fobj = new Formula(cline);
+  //Building database
+  if(!fobj->BuildFormula(cline))
+    exit(1);
+  //Compute Buildtime
+  difftime = fobj->TIME_E - fobj->TIME_S;
+  totaltime += difftime;
+  printf("%s \t%2.4f\t", cline->FILE, fabs(difftime));
+  //reinitialize the TIME_S and TIME_E
+  fobj->TIME_S = GetTime();
+  fobj->TIME_E = GetTime();
+  //call the algorithm
+  // fobj->checkUnit(); // move this check to the algo
+  result = Search(fobj, cline, type, report);
+  //the error is reported already
+  if(result == INPUTERROR)
+    exit(1);
+  fobj->TIME_E = GetTime();
 
   // compute the search time
   difftime = fobj->TIME_E - fobj->TIME_S;
@@ -84,9 +133,14 @@ void SolveFinite(CommandLine * cline, string type)
     cout<<"SAT"<<endl;
   else if(result == 1)
     cout<<"TIMEOUT"<<endl;
+  else if(result == CUBESWRITTEN)
+    cout<<"UNKNOWN"<<endl;
+  else if(result == MEMOUT)
+    cout<<"MEMOUT"<<endl;
   else
     cout<<"UNSAT"<<endl;
   fobj->PrintInfo();
+  cout<<report;
   if(result == 0)
    { if(cline->MODEL) { cout<<"The model: "<<endl;
      fobj->PrintModel(); }
@@ -97,4 +151,89 @@ void SolveFinite(CommandLine * cline, string type)
  	cout<<"model is INCORRECT"<<endl;
      }
 }
+
+//SolveBatch: solves the instances of the batch list or of the clients of
+//the socket one after the other, and answers each one with a line
+//<name> <SAT/UNSAT/TIMEOUT/UNKNOWN/MEMOUT/ERROR> <time> <decisions> <backtracks>
+void SolveBatch(CommandLine * cline, string type)
+{
+  RequestStream requests(cline->BATCH, cline->SOCKET);
+  Watchdog watchdog;
+  REQUEST request;
+  Formula * recycled = NULL;
+  //indexed by the result of the search, with ERROR last
+  int counts[6] = {0, 0, 0, 0, 0, 0};
+  const char * results[6] = {"SAT", "TIMEOUT", "UNSAT", "UNKNOWN", "MEMOUT", "ERROR"};
+  double start = GetTime();
+  char line[64];
+
+  while(requests.next(request))
+    {
+      //a file that cannot be read is answered, not fatal
+      if(!request.INLINE && access(request.NAME.c_str(), R_OK) != 0)
+	{
+	  counts[5]++;
+	  requests.reply(request.NAME + " ERROR");
+	  continue;
+	}
+
+      //the arenas of the last instance are handed on, so their
+      //blocks are not taken from the system again
+      Formula * fobj = new Formula(cline);
+      if(recycled)
+	{
+	  recycled->INPUTARENA.reset();
+	  recycled->ARENA.reset();
+	  fobj->INPUTARENA.swap(recycled->INPUTARENA);
+	  fobj->ARENA.swap(recycled->ARENA);
+	  delete recycled;
+	}
+      double begin = GetTime();
+      bool built;
+      if(request.INLINE)
+	built = fobj->parseFormula(request.TEXT.data(), request.TEXT.size());
+      else
+	{
+	  CommandLine instance = *cline;
+	  instance.FILE = (char *) request.NAME.c_str();
+	  built = fobj->BuildFormula(&instance);
+	}
+      //and so is a malformed one, its formula only hands on its arenas
+      if(!built)
+	{
+	  counts[5]++;
+	  requests.reply(request.NAME + " ERROR");
+	  recycled = fobj;
+	  continue;
+	}
+
+      //the time limit is the one of the instance, from its start
+      string report;
+      Formula * winner = fobj;
+      winner->TIME_S = GetTime();
+      winner->STOP = &watchdog.STOP;
+      watchdog.arm(cline->TIME);
+      int result = Search(winner, cline, type, report);
+      watchdog.disarm();
+      winner->TIME_E = GetTime();
+
+      snprintf(line, sizeof(line), " %2.4f %d %d", winner->TIME_E - begin,
+	       winner->DECISIONS, winner->BACKTRACKS);
+      string answer = request.NAME + " " + results[result] + line;
+      if(result == 0 && !winner->verifyModel())
+	answer += " model INCORRECT";
+      counts[result]++;
+      requests.reply(answer);
+      //a copy searched by a parallel mode reads the input clauses of
+      //fobj, so it goes first
+      if(winner != fobj)
+	delete winner;
+      recycled = fobj;
+    }
+  delete recycled;
+
+  cout<<"c "<<counts[0] + counts[1] + counts[2] + counts[3] + counts[4] + counts[5]<<" instances : "
+      <<counts[0]<<" SAT, "<<counts[2]<<" UNSAT, "<<counts[1]<<" TIMEOUT, "<<counts[3]<<" UNKNOWN, "
+      <<counts[4]<<" MEMOUT, "<<counts[5]<<" ERROR in "<<GetTime() - start<<" s"<<endl;
+}
 //**********************************************************************//
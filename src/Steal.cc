@@ -0,0 +1,92 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Steal.cc
+//**************************************************************
+
+//Including Libraries and Header Files
+#include "Steal.h"
+#include <thread>
+using namespace std;
+//**************************************************************
+//Start of Code
+
+//One argument constructor
+TaskPool::TaskPool(int threads)
+  : LOCKS(threads), DEQUES(threads)
+{
+  THREADS = threads;
+  HUNGRY = 0;
+  PENDING = 0;
+}
+
+//push
+void TaskPool::push(int thread, const vector <LIT> & task)
+{
+  //counted before it can be taken, so PENDING never drops to 0 too early
+  PENDING++;
+  lock_guard <mutex> lock(LOCKS[thread]);
+  DEQUES[thread].push_back(task);
+}
+
+//steal
+bool TaskPool::steal(int thread, bool back, vector <LIT> & task)
+{
+  lock_guard <mutex> lock(LOCKS[thread]);
+  if(DEQUES[thread].empty())
+    return false;
+  if(back)
+    {
+      task.swap(DEQUES[thread].back());
+      DEQUES[thread].pop_back();
+    }
+  else
+    {
+      task.swap(DEQUES[thread].front());
+      DEQUES[thread].pop_front();
+    }
+  return true;
+}
+
+//take
+bool TaskPool::take(int thread, vector <LIT> & task, const atomic<bool> & stop)
+{
+  bool waiting = false;
+  bool found = false;
+  while(!found && !stop && PENDING > 0)
+    {
+      found = steal(thread, true, task);
+      for(int i = 1; i < THREADS && !found; i++)
+	found = steal((thread + i) % THREADS, false, task);
+      if(!found)
+	{
+	  //the others see it and give away a subtree
+	  if(!waiting)
+	    HUNGRY++;
+	  waiting = true;
+	  this_thread::yield();
+	}
+    }
+  if(waiting)
+    HUNGRY--;
+  return found;
+}
+
+//finish
+void TaskPool::finish()
+{
+  PENDING--;
+}
+
+//wanted
+bool TaskPool::wanted(int thread)
+{
+  if(HUNGRY.load(memory_order_relaxed) == 0)
+    return false;
+  lock_guard <mutex> lock(LOCKS[thread]);
+  return DEQUES[thread].empty();
+}
+
+// End of Code
+//**************************************************************
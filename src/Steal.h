@@ -0,0 +1,68 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Steal.h
+// Description : Contains code for sharing out the subtrees of the
+// chronological search between threads. Every thread has a deque
+// of tasks: it takes its own latest task, and steals the oldest
+// task of another thread, which heads the largest subtree, when
+// its own deque is empty.
+//**************************************************************
+#ifndef STEAL_H
+#define STEAL_H
+
+//Including Libraries and Header files
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+
+#include "Literal.h"
+
+using namespace std;
+
+//**************************************************************
+// TaskPool
+// This class holds the tasks of the threads. A task is the path
+// from the root to a subtree, the atoms to assert one per level
+// before searching it. The pool knows how many tasks are queued or
+// being searched, so the threads can tell when the tree is done.
+//
+// Start of Code
+class TaskPool
+{
+  //public variables and functions
+public:
+  //One argument constructor : empty deques for threads threads
+  TaskPool(int threads);
+  //push : adds a task at the back of the deque of the thread
+  void push(int thread, const vector <LIT> & task);
+  //take : takes the latest task of the thread, or steals the oldest one of
+  //       another thread, waiting while others search; returns false once
+  //       no task is left anywhere, or when stop is set
+  bool take(int thread, vector <LIT> & task, const atomic<bool> & stop);
+  //finish : the subtree of a task taken is searched
+  void finish();
+  //wanted : returns true if a thread waits for a task and the deque of
+  //         the thread is empty, so it should give away a subtree
+  bool wanted(int thread);
+  //private variables and functions
+private:
+  //THREADS = number of deques
+  //LOCKS = the lock of each deque
+  //DEQUES = the tasks of each thread, the latest at the back
+  //HUNGRY = number of threads waiting for a task
+  //PENDING = number of tasks in the deques or being searched
+  int THREADS;
+  vector <mutex> LOCKS;
+  vector < deque < vector <LIT> > > DEQUES;
+  atomic<int> HUNGRY;
+  atomic<int> PENDING;
+  //steal : takes a task from the deque of the thread, from the back or the front
+  bool steal(int thread, bool back, vector <LIT> & task);
+};
+// End of Code
+//
+#endif
+//**************************************************************
@@ -0,0 +1,277 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Subsumption.cc
+//**************************************************************
+
+//Including Libraries and Header Files
+#include "Subsumption.h"
+#include <algorithm>
+using namespace std;
+//**************************************************************
+//Start of Code
+
+//Number of atoms the comparisons of clauses may go through, which
+//bounds the time a simplification takes
+#define SUBSUMECHECKS (1L << 27)
+
+//One argument constructor
+Subsumption::Subsumption(const vector <Variable *> & varlist)
+{
+  int largest = 0;
+  for(unsigned int i = 0; i < varlist.size(); i++)
+    {
+      DOMAINSIZES.push_back(varlist[i]->DOMAINSIZE);
+      largest = max(largest, varlist[i]->DOMAINSIZE);
+    }
+  OCCURS.resize(varlist.size());
+  MARKS.assign(largest, 0);
+  DUPLICATES = 0;
+  SUBSUMED = 0;
+  STRENGTHENED = 0;
+  TAUTOLOGIES = 0;
+  CHECKS = SUBSUMECHECKS;
+}
+
+//add
+int Subsumption::add(const LIT * atoms, int size, bool removable)
+{
+  vector <LIT> sorted(atoms, atoms + size);
+  sort(sorted.begin(), sorted.end());
+
+  //the values of each variable, marked, are written again
+  vector <LIT> clause;
+  for(unsigned int i = 0, j; i < sorted.size(); i = j)
+    {
+      int var = litVar(sorted[i]);
+      int count = 0;
+      for(j = i; j < sorted.size() && litVar(sorted[j]) == var; j++)
+	{
+	  int val = litVal(sorted[j]);
+	  if(litEqual(sorted[j]))
+	    {
+	      if(!MARKS[val])
+		count++;
+	      MARKS[val] = 1;
+	    }
+	  else
+	    for(int v = 0; v < DOMAINSIZES[var]; v++)
+	      if(v != val && !MARKS[v])
+		{
+		  MARKS[v] = 1;
+		  count++;
+		}
+	}
+      if(!rewrite(var, count, clause))
+	{
+	  TAUTOLOGIES++;
+	  return -1;
+	}
+    }
+
+  int c = CLAUSES.size();
+  CLAUSES.push_back(clause);
+  REMOVED.push_back(false);
+  CHANGED.push_back(clause != sorted);
+  REMOVABLE.push_back(removable);
+  SIGNATURES.push_back(0);
+  signature(c);
+  for(unsigned int i = 0; i < clause.size(); i++)
+    if(i == 0 || litVar(clause[i]) != litVar(clause[i - 1]))
+      OCCURS[litVar(clause[i])].push_back(c);
+  return c;
+}
+
+//simplify
+void Subsumption::simplify(bool strengthen)
+{
+  //the clauses that repeat one are next to it once they are sorted, the
+  //first one added stays
+  vector <int> order(CLAUSES.size());
+  for(unsigned int c = 0; c < order.size(); c++)
+    order[c] = c;
+  stable_sort(order.begin(), order.end(), [&](int a, int b) { return CLAUSES[a] < CLAUSES[b]; });
+  for(unsigned int k = 1, first = 0; k < order.size(); k++)
+    {
+      if(CLAUSES[order[k]] != CLAUSES[order[first]])
+	first = k;
+      else if(REMOVABLE[order[k]])
+	{
+	  REMOVED[order[k]] = true;
+	  DUPLICATES++;
+	}
+    }
+
+  //the short clauses subsume the most, they go first
+  vector <int> queue;
+  vector <bool> queued(CLAUSES.size(), false);
+  for(unsigned int c = 0; c < CLAUSES.size(); c++)
+    if(!REMOVED[c])
+      {
+	queue.push_back(c);
+	queued[c] = true;
+      }
+  stable_sort(queue.begin(), queue.end(), [&](int a, int b) { return CLAUSES[a].size() < CLAUSES[b].size(); });
+
+  for(unsigned int k = 0; k < queue.size() && CHECKS >= 0; k++)
+    {
+      int c = queue[k];
+      queued[c] = false;
+      if(REMOVED[c] || CLAUSES[c].empty())
+	continue;
+
+      //the clauses c subsumes or strengthens are over all its variables,
+      //those over the variable in the fewest clauses are enough
+      int var = litVar(CLAUSES[c][0]);
+      for(unsigned int i = 1; i < CLAUSES[c].size(); i++)
+	if(OCCURS[litVar(CLAUSES[c][i])].size() < OCCURS[var].size())
+	  var = litVar(CLAUSES[c][i]);
+
+      const vector <int> & occurs = OCCURS[var];
+      for(unsigned int i = 0; i < occurs.size() && CHECKS >= 0; i++)
+	{
+	  int d = occurs[i];
+	  if(d == c || REMOVED[d] || !REMOVABLE[d] || (SIGNATURES[c] & ~SIGNATURES[d]))
+	    continue;
+	  int result = compare(c, d);
+	  if(result == -1)
+	    {
+	      REMOVED[d] = true;
+	      SUBSUMED++;
+	    }
+	  else if(result >= 0 && strengthen && strengthenClause(c, d, result) && !queued[d])
+	    {
+	      queue.push_back(d);
+	      queued[d] = true;
+	    }
+	}
+    }
+}
+
+//values
+void Subsumption::values(const LIT * atoms, int size, vector <int> & values)
+{
+  values.clear();
+  if(litEqual(atoms[0]))
+    for(int i = 0; i < size; i++)
+      values.push_back(litVal(atoms[i]));
+  else
+    for(int v = 0; v < DOMAINSIZES[litVar(atoms[0])]; v++)
+      if(v != litVal(atoms[0]))
+	values.push_back(v);
+}
+
+//rewrite
+bool Subsumption::rewrite(int var, int count, vector <LIT> & clause)
+{
+  int domainsize = DOMAINSIZES[var];
+  int missing = -1;
+  for(int v = 0; v < domainsize; v++)
+    {
+      if(!MARKS[v])
+	missing = v;
+      else if(count < domainsize - 1)
+	clause.push_back(makeLit(var, true, v));
+      MARKS[v] = 0;
+    }
+  if(count == domainsize - 1)
+    clause.push_back(makeLit(var, false, missing));
+  return count < domainsize;
+}
+
+//signature
+void Subsumption::signature(int c)
+{
+  SIGNATURES[c] = 0;
+  for(unsigned int i = 0; i < CLAUSES[c].size(); i++)
+    SIGNATURES[c] |= (uint64_t) 1 << (litVar(CLAUSES[c][i]) & 63);
+}
+
+//compare
+int Subsumption::compare(int c, int d)
+{
+  const vector <LIT> & first = CLAUSES[c];
+  const vector <LIT> & second = CLAUSES[d];
+  CHECKS -= first.size() + second.size();
+
+  //a clause has either x!=a or atoms x=b for a variable, x!=a has all the
+  //values but a, and x=b only b
+  int failed = -1;
+  unsigned int j = 0;
+  for(unsigned int i = 0, k; i < first.size(); i = k)
+    {
+      int var = litVar(first[i]);
+      for(k = i; k < first.size() && litVar(first[k]) == var; k++)
+	;
+      while(j < second.size() && litVar(second[j]) < var)
+	j++;
+      if(j == second.size() || litVar(second[j]) != var)
+	return -2;
+      unsigned int l;
+      for(l = j; l < second.size() && litVar(second[l]) == var; l++)
+	;
+
+      bool covered = true;
+      if(!litEqual(first[i]))
+	covered = first[i] == second[j];
+      else if(!litEqual(second[j]))
+	for(unsigned int m = i; m < k; m++)
+	  covered = covered && litVal(first[m]) != litVal(second[j]);
+      else
+	covered = includes(second.begin() + j, second.begin() + l, first.begin() + i, first.begin() + k);
+      j = l;
+
+      if(covered)
+	continue;
+      if(failed >= 0)
+	return -2;
+      failed = var;
+    }
+  return failed;
+}
+
+//strengthenClause
+bool Subsumption::strengthenClause(int c, int d, int var)
+{
+  const vector <LIT> & other = CLAUSES[c];
+  vector <LIT> & clause = CLAUSES[d];
+  vector <int> others;
+  vector <int> all;
+  vector <int> kept;
+
+  //resolving on var leaves the values of var both clauses have
+  unsigned int i = 0, k, j = 0, l;
+  while(litVar(other[i]) != var)
+    i++;
+  for(k = i; k < other.size() && litVar(other[k]) == var; k++)
+    ;
+  while(litVar(clause[j]) != var)
+    j++;
+  for(l = j; l < clause.size() && litVar(clause[l]) == var; l++)
+    ;
+  values(&other[i], k - i, others);
+  for(unsigned int m = 0; m < others.size(); m++)
+    MARKS[others[m]] = 1;
+  values(&clause[j], l - j, all);
+  for(unsigned int m = 0; m < all.size(); m++)
+    if(MARKS[all[m]])
+      kept.push_back(all[m]);
+  fill(MARKS.begin(), MARKS.begin() + DOMAINSIZES[var], 0);
+
+  //fewer values than d had, but not the empty clause
+  if(kept.size() == all.size() || (kept.empty() && l - j == clause.size()))
+    return false;
+  vector <LIT> strengthened(clause.begin(), clause.begin() + j);
+  for(unsigned int m = 0; m < kept.size(); m++)
+    strengthened.push_back(makeLit(var, true, kept[m]));
+  strengthened.insert(strengthened.end(), clause.begin() + l, clause.end());
+  clause.swap(strengthened);
+  STRENGTHENED += all.size() - kept.size();
+  CHANGED[d] = true;
+  signature(d);
+  return true;
+}
+
+// End of Code
+//**************************************************************
@@ -0,0 +1,94 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Subsumption.h
+// Description : Contains code for the simplification of a set of
+// clauses. The atoms of each variable in a clause stand for the
+// values they let it take, so x!=a covers x=b for any b other than
+// a. A clause whose values are all among those of another makes it
+// redundant, and one that does so but for a single variable takes
+// away from the other the values of that variable it does not have
+// (self subsuming resolution).
+//**************************************************************
+#ifndef SUBSUMPTION_H
+#define SUBSUMPTION_H
+
+//Including Libraries and Header files
+#include <vector>
+#include <stdint.h>
+
+#include "Literal.h"
+#include "Variable.h"
+
+using namespace std;
+
+//**************************************************************
+// Subsumption
+// This class holds the clauses being simplified, each one rewritten
+// with the atoms of a variable as x!=a if they let it take all values
+// but a, as the atoms x=b of the values they let it take otherwise.
+// The clauses are looked up through the variables they are over and
+// a signature of them, one bit for each 64th variable.
+//
+// Start of Code
+class Subsumption
+{
+  //public variables and functions
+public:
+  //One argument constructor : the clauses will be over the variables
+  Subsumption(const vector <Variable *> & varlist);
+  //CLAUSES = the clauses, rewritten, their atoms sorted
+  //REMOVED = true for a clause that repeats or is subsumed by another one
+  //CHANGED = true for a clause whose atoms are no longer those it was added with
+  vector < vector <LIT> > CLAUSES;
+  vector <bool> REMOVED;
+  vector <bool> CHANGED;
+  //DUPLICATES = number of clauses removed as they repeat another one
+  //SUBSUMED = number of clauses removed as another one subsumes them
+  //STRENGTHENED = number of values taken away from the variables of clauses
+  //TAUTOLOGIES = number of clauses not added as they let a variable take any value
+  int DUPLICATES;
+  int SUBSUMED;
+  int STRENGTHENED;
+  int TAUTOLOGIES;
+  //add : adds the clause of the atoms, which only simplify removes or changes
+  //      if removable; returns its number, -1 for a tautology
+  int add(const LIT * atoms, int size, bool removable);
+  //simplify : removes the clauses that repeat or are subsumed by another one,
+  //           and strengthens the others if strengthen is true
+  void simplify(bool strengthen);
+  //private variables and functions
+private:
+  //DOMAINSIZES = the domain size of each variable
+  //REMOVABLE = true for a clause simplify may remove or change
+  //SIGNATURES = the bits of the variables of each clause
+  //OCCURS = the clauses over each variable
+  //MARKS = a mark for each value, all cleared between two uses
+  //CHECKS = number of atoms the comparisons of clauses may still go through
+  vector <int> DOMAINSIZES;
+  vector <bool> REMOVABLE;
+  vector <uint64_t> SIGNATURES;
+  vector < vector <int> > OCCURS;
+  vector <char> MARKS;
+  long CHECKS;
+  //values : puts in values the values the atoms of one variable let it take
+  void values(const LIT * atoms, int size, vector <int> & values);
+  //rewrite : adds to clause the atoms letting var take the values marked, of
+  //          which there are count; returns false if that is all of them
+  bool rewrite(int var, int count, vector <LIT> & clause);
+  //signature : computes the signature of the clause
+  void signature(int c);
+  //compare : returns -1 if the clause c subsumes the clause d, the variable
+  //          whose values of d it takes away from d if it strengthens d, -2
+  //          otherwise
+  int compare(int c, int d);
+  //strengthenClause : takes away from the clause d the values of var the
+  //                   clause c does not have; returns false if none or all
+  //                   of them are
+  bool strengthenClause(int c, int d, int var);
+};
+// End of Code
+//
+#endif
+//**************************************************************
@@ -0,0 +1,411 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Symmetry.cc
+//**************************************************************
+
+//Including Libraries and Header Files
+#include "Symmetry.h"
+#include <algorithm>
+#include <map>
+#include <stdint.h>
+using namespace std;
+//**************************************************************
+//Start of Code
+
+//Number of rounds of the colour refinement at most
+#define COLOURROUNDS 16
+//Number of literals the checks of the swaps may map, which bounds the
+//time the symmetries are looked for
+#define SYMMETRYCHECKS (1L << 26)
+//Number of atoms of the clauses breaking the symmetries at most
+#define SYMMETRYATOMS (1 << 20)
+
+//CLAUSESET
+//The distinct clauses of the input, and the swap of atoms checked
+struct CLAUSESET
+{
+  //LITS = the literals of the clauses, sorted, one clause after the
+  //       other, the clauses in lexicographic order
+  //START = where each clause starts in LITS, and where the last one ends
+  //OCCURS = for each atom, twice the number of each clause it is in, plus
+  //         one if it is there with =
+  //ATOMVAR = the variable of each atom
+  //IMAGE = the atom each atom is mapped to by the swap checked
+  //MARK = the last swap each clause was mapped by
+  //SWAPS = number of swaps checked
+  //CHECKS = number of literals the checks may still map
+  vector <LIT> LITS;
+  vector <int> START;
+  vector < vector <int> > OCCURS;
+  vector <int> ATOMVAR;
+  vector <int> IMAGE;
+  vector <int> MARK;
+  int SWAPS;
+  long CHECKS;
+};
+
+//atomOf
+//Returns the number of the atom of a literal
+static inline int atomOf(Formula * formula, LIT lit)
+{
+  return formula->ATOMBASE[litVar(lit)] + litVal(lit);
+}
+
+//mix
+//Scrambles the bits of a colour, so that sums of colours rarely clash
+static inline uint64_t mix(uint64_t x)
+{
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+//readClauses
+//Fills set with the clauses of the input of formula, each one once
+static void readClauses(Formula * formula, CLAUSESET & set)
+{
+  vector <LIT> lits;
+  vector <int> start(1, 0);
+  for(int c = 0; c < formula->ORIGINALCLAUSES; c++)
+    {
+      Clause * clause = formula->CLAUSELIST[c];
+      lits.insert(lits.end(), clause->ATOM_LIST, clause->ATOM_LIST + clause->NumAtom);
+      sort(lits.begin() + start.back(), lits.end());
+      lits.erase(unique(lits.begin() + start.back(), lits.end()), lits.end());
+      start.push_back(lits.size());
+    }
+
+  vector <int> order(start.size() - 1);
+  for(unsigned int c = 0; c < order.size(); c++)
+    order[c] = c;
+  sort(order.begin(), order.end(), [&](int a, int b) {
+      return lexicographical_compare(lits.begin() + start[a], lits.begin() + start[a + 1],
+				     lits.begin() + start[b], lits.begin() + start[b + 1]);
+    });
+
+  int atoms = formula->ATOMBASE.back() + formula->VARLIST.back()->DOMAINSIZE;
+  set.OCCURS.assign(atoms, vector <int> ());
+  set.ATOMVAR.resize(atoms);
+  set.IMAGE.resize(atoms);
+  for(unsigned int i = 0; i < formula->VARLIST.size(); i++)
+    for(int j = 0; j < formula->VARLIST[i]->DOMAINSIZE; j++)
+      set.ATOMVAR[formula->ATOMBASE[i] + j] = i;
+  for(int a = 0; a < atoms; a++)
+    set.IMAGE[a] = a;
+
+  set.START.assign(1, 0);
+  for(unsigned int k = 0; k < order.size(); k++)
+    {
+      int c = order[k];
+      int size = start[c + 1] - start[c];
+      int last = set.START.size() - 2;
+      if(last >= 0 && size == set.START[last + 1] - set.START[last]
+	 && equal(lits.begin() + start[c], lits.begin() + start[c + 1], set.LITS.begin() + set.START[last]))
+	continue;
+      int id = set.START.size() - 1;
+      for(int i = start[c]; i < start[c + 1]; i++)
+	{
+	  set.LITS.push_back(lits[i]);
+	  set.OCCURS[atomOf(formula, lits[i])].push_back(2 * id + (litEqual(lits[i]) ? 1 : 0));
+	}
+      set.START.push_back(set.LITS.size());
+    }
+  set.MARK.assign(set.START.size() - 1, 0);
+  set.SWAPS = 0;
+  set.CHECKS = SYMMETRYCHECKS;
+}
+
+//countColours
+//Returns the number of different colours
+static int countColours(vector <uint64_t> colours)
+{
+  sort(colours.begin(), colours.end());
+  return unique(colours.begin(), colours.end()) - colours.begin();
+}
+
+//refineColours
+//Colours the atoms so that the atoms a symmetry maps onto each other
+//have the same colour: first by the domain size of their variable, then
+//by the colours of the clauses they are in and of the other atoms of
+//their variable, until the colours split no further
+static void refineColours(Formula * formula, CLAUSESET & set, vector <uint64_t> & colours)
+{
+  int atoms = set.ATOMVAR.size();
+  int clauses = set.START.size() - 1;
+  colours.resize(atoms);
+  for(int a = 0; a < atoms; a++)
+    colours[a] = formula->VARLIST[set.ATOMVAR[a]]->DOMAINSIZE;
+  int count = countColours(colours);
+
+  vector <uint64_t> clausecolours(clauses);
+  vector <uint64_t> varcolours;
+  vector <uint64_t> refined(atoms);
+  for(int round = 0; round < COLOURROUNDS; round++)
+    {
+      //the sums do not depend on the order of the atoms and clauses
+      for(int c = 0; c < clauses; c++)
+	{
+	  uint64_t colour = mix(set.START[c + 1] - set.START[c]);
+	  for(int i = set.START[c]; i < set.START[c + 1]; i++)
+	    colour += mix(2 * colours[atomOf(formula, set.LITS[i])] + (litEqual(set.LITS[i]) ? 1 : 0));
+	  clausecolours[c] = colour;
+	}
+      varcolours.assign(formula->VARLIST.size(), 0);
+      for(int a = 0; a < atoms; a++)
+	varcolours[set.ATOMVAR[a]] += mix(colours[a]);
+      for(int a = 0; a < atoms; a++)
+	{
+	  uint64_t occurs = 0;
+	  for(unsigned int k = 0; k < set.OCCURS[a].size(); k++)
+	    occurs += mix(2 * clausecolours[set.OCCURS[a][k] >> 1] + (set.OCCURS[a][k] & 1));
+	  refined[a] = mix(mix(colours[a]) + 3 * mix(occurs) + 5 * mix(varcolours[set.ATOMVAR[a]]));
+	}
+      colours.swap(refined);
+
+      int refinedcount = countColours(colours);
+      if(refinedcount == count)
+	break;
+      count = refinedcount;
+    }
+}
+
+//findClause
+//Returns true if the clause of the sorted literals is in set
+static bool findClause(const CLAUSESET & set, const vector <LIT> & clause)
+{
+  int low = 0;
+  int high = set.START.size() - 1;
+  while(low < high)
+    {
+      int middle = (low + high) / 2;
+      if(lexicographical_compare(set.LITS.begin() + set.START[middle], set.LITS.begin() + set.START[middle + 1],
+				 clause.begin(), clause.end()))
+	low = middle + 1;
+      else
+	high = middle;
+    }
+  return low < (int) set.START.size() - 1
+    && set.START[low + 1] - set.START[low] == (int) clause.size()
+    && equal(clause.begin(), clause.end(), set.LITS.begin() + set.START[low]);
+}
+
+//swapAtoms
+//Returns true if the swap of each atom of first with the atom of second
+//at the same place maps each clause of set onto a clause of set, which
+//is checked for the clauses with atoms swapped only; false as well once
+//the checks may map no more literals
+static bool swapAtoms(Formula * formula, CLAUSESET & set, const vector <int> & first, const vector <int> & second)
+{
+  for(unsigned int i = 0; i < first.size(); i++)
+    {
+      set.IMAGE[first[i]] = second[i];
+      set.IMAGE[second[i]] = first[i];
+    }
+
+  bool symmetry = true;
+  vector <LIT> image;
+  set.SWAPS++;
+  for(unsigned int i = 0; i < 2 * first.size() && symmetry; i++)
+    {
+      const vector <int> & occurs = set.OCCURS[i < first.size() ? first[i] : second[i - first.size()]];
+      for(unsigned int k = 0; k < occurs.size() && symmetry; k++)
+	{
+	  int c = occurs[k] >> 1;
+	  if(set.MARK[c] == set.SWAPS)
+	    continue;
+	  set.MARK[c] = set.SWAPS;
+	  set.CHECKS -= set.START[c + 1] - set.START[c];
+	  image.clear();
+	  for(int l = set.START[c]; l < set.START[c + 1]; l++)
+	    {
+	      int atom = set.IMAGE[atomOf(formula, set.LITS[l])];
+	      int var = set.ATOMVAR[atom];
+	      image.push_back(makeLit(var, litEqual(set.LITS[l]), atom - formula->ATOMBASE[var]));
+	    }
+	  sort(image.begin(), image.end());
+	  symmetry = set.CHECKS >= 0 && findClause(set, image);
+	}
+    }
+
+  for(unsigned int i = 0; i < first.size(); i++)
+    {
+      set.IMAGE[first[i]] = first[i];
+      set.IMAGE[second[i]] = second[i];
+    }
+  return symmetry;
+}
+
+//findClasses
+//Splits the candidates into classes whose members the swap with the
+//first one maps onto each other, as the swaps with the first member
+//give every permutation of a class; adds to classes those of two
+//members or more
+template <class SWAP>
+static void findClasses(const CLAUSESET & set, vector <int> candidates, SWAP swap, vector < vector <int> > & classes)
+{
+  while(candidates.size() > 1 && set.CHECKS >= 0)
+    {
+      vector <int> found(1, candidates[0]);
+      vector <int> rest;
+      for(unsigned int i = 1; i < candidates.size(); i++)
+	if(swap(candidates[0], candidates[i]))
+	  found.push_back(candidates[i]);
+	else
+	  rest.push_back(candidates[i]);
+      if(found.size() > 1)
+	classes.push_back(found);
+      candidates.swap(rest);
+    }
+}
+
+//findCandidates
+//Splits the items into the candidates of each key, the items in order
+//in each, and calls found for those of two items or more
+template <class FOUND>
+static void findCandidates(vector < pair <uint64_t, int> > & keys, FOUND found)
+{
+  sort(keys.begin(), keys.end());
+  for(unsigned int i = 0, j; i < keys.size(); i = j)
+    {
+      vector <int> candidates;
+      for(j = i; j < keys.size() && keys[j].first == keys[i].first; j++)
+	candidates.push_back(keys[j].second);
+      if(candidates.size() > 1)
+	found(candidates);
+    }
+}
+
+//addBreaking
+//Adds the clause to atoms and sizes; returns false, adding nothing, if
+//the clauses would have more than SYMMETRYATOMS atoms
+static bool addBreaking(const vector <LIT> & clause, vector <LIT> & atoms, vector <int> & sizes)
+{
+  if(atoms.size() + clause.size() > SYMMETRYATOMS)
+    return false;
+  atoms.insert(atoms.end(), clause.begin(), clause.end());
+  sizes.push_back(clause.size());
+  return true;
+}
+
+//BreakSymmetries
+void BreakSymmetries(Formula * formula, string & report)
+{
+  double start = GetTime();
+  char line[256];
+  if(!formula->CONSTRAINTS.empty() || !formula->AMOS.empty())
+    {
+      report = "Symmetries  : not looked for, the formula has constraints that are not clauses\n";
+      return;
+    }
+
+  CLAUSESET set;
+  vector <uint64_t> colours;
+  readClauses(formula, set);
+  refineColours(formula, set, colours);
+
+  //the variables of each domain size, the swaps of values are on all of them
+  map < int, vector <int> > groups;
+  for(unsigned int i = 1; i < formula->VARLIST.size(); i++)
+    if(formula->VARLIST[i]->DOMAINSIZE > 1)
+      groups[formula->VARLIST[i]->DOMAINSIZE].push_back(i);
+
+  vector <LIT> atoms;
+  vector <int> sizes;
+  vector <LIT> clause;
+  bool full = false;
+  int valueclasses = 0;
+  int varclasses = 0;
+  for(map < int, vector <int> >::iterator g = groups.begin(); g != groups.end(); ++g)
+    {
+      int domainsize = g->first;
+      const vector <int> & vars = g->second;
+      vector < vector <int> > values;
+      vector < vector <int> > symmetric;
+      vector < pair <uint64_t, int> > keys;
+
+      //a value takes the colours of its atoms, variable by variable
+      for(int a = 0; a < domainsize; a++)
+	{
+	  uint64_t key = 0;
+	  for(unsigned int i = 0; i < vars.size(); i++)
+	    key = mix(key + colours[formula->ATOMBASE[vars[i]] + a]);
+	  keys.push_back(make_pair(key, a));
+	}
+      findCandidates(keys, [&](const vector <int> & candidates) {
+	  findClasses(set, candidates, [&](int a, int b) {
+	      vector <int> first, second;
+	      for(unsigned int i = 0; i < vars.size(); i++)
+		{
+		  first.push_back(formula->ATOMBASE[vars[i]] + a);
+		  second.push_back(formula->ATOMBASE[vars[i]] + b);
+		}
+	      return swapAtoms(formula, set, first, second);
+	    }, values);
+	});
+
+      //a variable takes the colours of its atoms, value by value
+      keys.clear();
+      for(unsigned int i = 0; i < vars.size(); i++)
+	{
+	  uint64_t key = 0;
+	  for(int a = 0; a < domainsize; a++)
+	    key = mix(key + colours[formula->ATOMBASE[vars[i]] + a]);
+	  keys.push_back(make_pair(key, vars[i]));
+	}
+      findCandidates(keys, [&](const vector <int> & candidates) {
+	  findClasses(set, candidates, [&](int x, int y) {
+	      vector <int> first, second;
+	      for(int a = 0; a < domainsize; a++)
+		{
+		  first.push_back(formula->ATOMBASE[x] + a);
+		  second.push_back(formula->ATOMBASE[y] + a);
+		}
+	      return swapAtoms(formula, set, first, second);
+	    }, symmetric);
+	});
+      valueclasses += values.size();
+      varclasses += symmetric.size();
+
+      //both are the assignments least in the order of the variables, then
+      //of the values, among their symmetric ones, so they hold together:
+      //the variables of a class take values in order, y <= z being
+      //y!=a or z is one of a ... domainsize - 1
+      for(unsigned int k = 0; k < symmetric.size() && !full; k++)
+	for(unsigned int i = 0; i + 1 < symmetric[k].size() && !full; i++)
+	  for(int a = 1; a < domainsize && !full; a++)
+	    {
+	      clause.assign(1, makeLit(symmetric[k][i], false, a));
+	      for(int b = a; b < domainsize; b++)
+		clause.push_back(makeLit(symmetric[k][i + 1], true, b));
+	      full = !addBreaking(clause, atoms, sizes);
+	    }
+
+      //the values c0 < c1 < ... of a class first appear in order: the i-th
+      //variable takes cj only if one before it takes cj-1, and never if
+      //fewer than j variables come before it
+      for(unsigned int i = 0; i < vars.size() && !full; i++)
+	for(unsigned int k = 0; k < values.size() && !full; k++)
+	  for(unsigned int j = 1; j < values[k].size() && !full; j++)
+	    {
+	      clause.assign(1, makeLit(vars[i], false, values[k][j]));
+	      if(i >= j)
+		for(unsigned int l = 0; l < i; l++)
+		  clause.push_back(makeLit(vars[l], true, values[k][j - 1]));
+	      full = !addBreaking(clause, atoms, sizes);
+	    }
+    }
+
+  formula->addRootClauses(atoms, sizes);
+  snprintf(line, sizeof(line), "Symmetries  : %d classes of values, %d of variables, %d clauses of %d atoms breaking them in %2.4f\n",
+	   valueclasses, varclasses, (int) sizes.size(), (int) atoms.size(), GetTime() - start);
+  report = line;
+  if(full)
+    report += "Symmetries  : the clauses beyond " + to_string(SYMMETRYATOMS) + " atoms were left out\n";
+}
+
+// End of Code
+//**************************************************************
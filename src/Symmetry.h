@@ -0,0 +1,35 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Symmetry.h
+// Description : Contains code for symmetry breaking. The values
+// that the clauses of the input treat alike, on all the variables
+// of a domain size, and the variables they treat alike are found,
+// and clauses keeping a single assignment of each class of
+// symmetric ones are added before the search starts.
+//**************************************************************
+#ifndef SYMMETRY_H
+#define SYMMETRY_H
+
+//Including Libraries and Header files
+#include <string>
+
+#include "Formula.h"
+
+using namespace std;
+
+//**************************************************************
+//BreakSymmetries
+//Colours the atoms of formula by how they occur in its clauses of
+//the input, then checks which swaps of two values of the variables
+//of a domain size, and of two variables, map the clauses onto
+//themselves. The values that any swap of a class maps onto each
+//other take their first places in order (value precedence), the
+//variables of a class take values in order (lex leader); the clauses
+//saying so are added at the level 0. Sets report to the classes
+//found and the clauses added. A formula with constraints that are
+//not clauses is left as it is
+void BreakSymmetries(Formula * formula, string & report);
+#endif
+//**************************************************************
@@ -0,0 +1,256 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Table.cc
+//**************************************************************
+
+//Including Libraries and Header Files
+#include "Table.h"
+#include <algorithm>
+using namespace std;
+//**************************************************************
+//Start of Code
+
+//Three argument constructor
+Table::Table(const vector <int> & vars, const vector <int> & tuples, const vector <Variable *> & varlist)
+  : TUPLES(tuples)
+{
+  VARS = vars;
+  int arity = VARS.size();
+  int count = TUPLES.size() / arity;
+  //an empty table still has a word, which is zero
+  WORDS = max(1, (count + 63) / 64);
+
+  int values = 0;
+  OFFSET.resize(arity);
+  SIZES.resize(arity);
+  for(int i = 0; i < arity; i++)
+    {
+      OFFSET[i] = values;
+      SIZES[i] = varlist[VARS[i]]->DOMAINSIZE;
+      values += SIZES[i];
+    }
+  SUPPORTS.assign((size_t) values * WORDS, 0);
+  RESIDUE.assign(values, 0);
+  for(int t = 0; t < count; t++)
+    for(int i = 0; i < arity; i++)
+      SUPPORTS[(size_t) (OFFSET[i] + TUPLES[t * arity + i]) * WORDS + t / 64] |= (uint64_t) 1 << (t % 64);
+
+  CURRENT.assign(WORDS, ~(uint64_t) 0);
+  if(count % 64)
+    CURRENT[WORDS - 1] = ((uint64_t) 1 << (count % 64)) - 1;
+  if(count == 0)
+    CURRENT[0] = 0;
+  NONZERO.resize(WORDS);
+  for(int w = 0; w < WORDS; w++)
+    NONZERO[w] = w;
+  LIMIT = count == 0 ? 0 : WORDS;
+}
+
+//domainSize
+int Table::domainSize(const vector <Variable *> & varlist, int i) const
+{
+  Variable * variable = varlist[VARS[i]];
+  int size = 0;
+  for(int value = 0; value < variable->DOMAINSIZE; value++)
+    if(variable->ATOMASSIGN[value] != -1)
+      size++;
+  return size;
+}
+
+//save
+void Table::save(int time)
+{
+  if(!TIMES.empty() && TIMES.back() == time)
+    return;
+  TIMES.push_back(time);
+  SAVEDCOUNT.push_back(SAVEDWORDS.size());
+  SAVEDLIMIT.push_back(LIMIT);
+  SAVEDSIZES.insert(SAVEDSIZES.end(), SIZES.begin(), SIZES.end());
+}
+
+//intersect
+void Table::intersect(const vector <Variable *> & varlist, int i)
+{
+  Variable * variable = varlist[VARS[i]];
+  //a word that becomes zero is swapped past the limit
+  for(int k = LIMIT - 1; k >= 0; k--)
+    {
+      int word = NONZERO[k];
+      uint64_t mask = 0;
+      for(int value = 0; value < variable->DOMAINSIZE; value++)
+	if(variable->ATOMASSIGN[value] != -1)
+	  mask |= support(i, value)[word];
+      if((CURRENT[word] & mask) == CURRENT[word])
+	continue;
+      SAVEDWORDS.push_back(word);
+      SAVEDVALUES.push_back(CURRENT[word]);
+      CURRENT[word] &= mask;
+      if(CURRENT[word] == 0)
+	{
+	  NONZERO[k] = NONZERO[LIMIT - 1];
+	  NONZERO[LIMIT - 1] = word;
+	  LIMIT--;
+	}
+    }
+}
+
+//supported
+bool Table::supported(int i, int value)
+{
+  const uint64_t * bits = support(i, value);
+  int & residue = RESIDUE[OFFSET[i] + value];
+  if(CURRENT[residue] & bits[residue])
+    return true;
+  for(int k = 0; k < LIMIT; k++)
+    if(CURRENT[NONZERO[k]] & bits[NONZERO[k]])
+      {
+	residue = NONZERO[k];
+	return true;
+      }
+  return false;
+}
+
+//explain
+int Table::explain(const vector <Variable *> & varlist, int i, int value, vector <LIT> & atoms) const
+{
+  int added = 0;
+  for(unsigned int j = 0; j < VARS.size(); j++)
+    {
+      if((int) j == i)
+	continue;
+      Variable * variable = varlist[VARS[j]];
+      //a variable with a value keeps out all the others at once
+      if(variable->SAT)
+	{
+	  atoms.push_back(makeLit(VARS[j], false, variable->VAL));
+	  added++;
+	  continue;
+	}
+      for(int other = 0; other < variable->DOMAINSIZE; other++)
+	{
+	  if(variable->ATOMASSIGN[other] != -1)
+	    continue;
+	  //only the values of the tuples that have to be ruled out
+	  const uint64_t * bits = support(j, other);
+	  const uint64_t * given = i < 0 ? bits : support(i, value);
+	  bool shared = false;
+	  for(int w = 0; w < WORDS && !shared; w++)
+	    shared = (bits[w] & given[w]) != 0;
+	  if(shared)
+	    {
+	      atoms.push_back(makeLit(VARS[j], true, other));
+	      added++;
+	    }
+	}
+    }
+  return added;
+}
+
+//propagate
+bool Table::propagate(const vector <Variable *> & varlist, int time, vector <LIT> & atoms, vector <int> & sizes)
+{
+  int arity = VARS.size();
+
+  //the tuples giving a value taken away since the last update are not valid
+  for(int i = 0; i < arity; i++)
+    {
+      int size = domainSize(varlist, i);
+      if(size == SIZES[i])
+	continue;
+      save(time);
+      SIZES[i] = size;
+      intersect(varlist, i);
+    }
+  if(LIMIT == 0)
+    {
+      sizes.push_back(explain(varlist, -1, 0, atoms));
+      return false;
+    }
+
+  //the values no valid tuple gives are taken away
+  for(int i = 0; i < arity; i++)
+    {
+      Variable * variable = varlist[VARS[i]];
+      if(variable->SAT)
+	continue;
+      for(int value = 0; value < variable->DOMAINSIZE; value++)
+	if(variable->ATOMASSIGN[value] != -1 && !supported(i, value))
+	  {
+	    atoms.push_back(makeLit(VARS[i], false, value));
+	    sizes.push_back(1 + explain(varlist, i, value, atoms));
+	  }
+    }
+  return true;
+}
+
+//undo
+void Table::undo(int stop)
+{
+  int arity = SIZES.size();
+  while(!TIMES.empty() && TIMES.back() > stop)
+    {
+      for(int k = SAVEDWORDS.size() - 1; k >= SAVEDCOUNT.back(); k--)
+	CURRENT[SAVEDWORDS[k]] = SAVEDVALUES[k];
+      SAVEDWORDS.resize(SAVEDCOUNT.back());
+      SAVEDVALUES.resize(SAVEDCOUNT.back());
+      LIMIT = SAVEDLIMIT.back();
+      copy(SAVEDSIZES.end() - arity, SAVEDSIZES.end(), SIZES.begin());
+      SAVEDSIZES.resize(SAVEDSIZES.size() - arity);
+      TIMES.pop_back();
+      SAVEDCOUNT.pop_back();
+      SAVEDLIMIT.pop_back();
+    }
+}
+
+//holds
+bool Table::holds(const vector <Variable *> & varlist) const
+{
+  int arity = VARS.size();
+  for(unsigned int t = 0; t < TUPLES.size(); t += arity)
+    {
+      int i = 0;
+      while(i < arity && varlist[VARS[i]]->VAL == TUPLES[t + i])
+	i++;
+      if(i == arity)
+	return true;
+    }
+  return false;
+}
+
+//decompose
+void Table::decompose(const vector <Variable *> & varlist, vector <LIT> & atoms, vector <int> & sizes) const
+{
+  //the tuples allowed in order, then every tuple of the domains not among them
+  int arity = VARS.size();
+  vector < vector <int> > allowed;
+  for(unsigned int t = 0; t < TUPLES.size(); t += arity)
+    allowed.push_back(vector <int> (TUPLES.begin() + t, TUPLES.begin() + t + arity));
+  sort(allowed.begin(), allowed.end());
+
+  vector <int> tuple(arity, 0);
+  while(true)
+    {
+      if(!binary_search(allowed.begin(), allowed.end(), tuple))
+	{
+	  for(int i = 0; i < arity; i++)
+	    atoms.push_back(makeLit(VARS[i], false, tuple[i]));
+	  sizes.push_back(arity);
+	}
+      int i = arity - 1;
+      while(i >= 0 && ++tuple[i] == varlist[VARS[i]]->DOMAINSIZE)
+	tuple[i--] = 0;
+      if(i < 0)
+	break;
+    }
+}
+
+//clone
+Constraint * Table::clone(const vector <Variable *> & varlist) const
+{
+  return new Table(VARS, TUPLES, varlist);
+}
+
+// End of Code
+//**************************************************************
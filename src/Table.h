@@ -0,0 +1,100 @@
+//**************************************************************
+//
+// Finite Domain Solver
+//
+// File : Table.h
+// Description : Contains code for the table constraint, which lists
+// the tuples of values its variables may take. The tuples still
+// valid are kept in a bitset, a value of a variable is taken away
+// once none of them gives it, and the values already taken away
+// from the other variables explain it.
+//**************************************************************
+#ifndef TABLE_H
+#define TABLE_H
+
+//Including Libraries and Header files
+#include <vector>
+#include <stdint.h>
+
+#include "Constraint.h"
+
+using namespace std;
+
+//**************************************************************
+// Table
+// This class holds the tuples of one table constraint and the
+// bitset of those that are still valid, compact table style: a bit
+// for each tuple, the words left nonzero listed first, and a bitset
+// of the tuples giving each value to each variable. The changes of
+// the bitset are saved with the number of atoms of the trail they
+// follow from, so a backtrack restores it.
+//
+// Start of Code
+class Table : public Constraint
+{
+  //public variables and functions
+public:
+  //Three argument constructor : the constraint over the variables, allowing
+  //                             the tuples listed one after the other
+  Table(const vector <int> & vars, const vector <int> & tuples, const vector <Variable *> & varlist);
+  //TUPLES = the values of the tuples allowed, one tuple after the other
+  vector <int> TUPLES;
+  //propagate : fails if no tuple is valid
+  bool propagate(const vector <Variable *> & varlist, int time, vector <LIT> & atoms, vector <int> & sizes);
+  //undo : restores the bitset saved after stop
+  void undo(int stop);
+  //holds : returns true if the values of the variables are a tuple
+  bool holds(const vector <Variable *> & varlist) const;
+  //decompose : a clause for each tuple of values not allowed
+  void decompose(const vector <Variable *> & varlist, vector <LIT> & atoms, vector <int> & sizes) const;
+  //clone : returns the constraint over the same variables and tuples
+  Constraint * clone(const vector <Variable *> & varlist) const;
+  //private variables and functions
+private:
+  //WORDS = number of words of a bitset
+  //OFFSET = where the values of each variable start among the bitsets
+  //SUPPORTS = the bitset of the tuples giving each value to each variable
+  //RESIDUE = the word where a tuple giving each value was found last
+  int WORDS;
+  vector <int> OFFSET;
+  vector <uint64_t> SUPPORTS;
+  vector <int> RESIDUE;
+  //CURRENT = the bitset of the tuples still valid
+  //NONZERO = the words of CURRENT, those that are not zero first
+  //LIMIT = number of words of CURRENT that are not zero
+  //SIZES = domain size of each variable when CURRENT was last updated
+  vector <uint64_t> CURRENT;
+  vector <int> NONZERO;
+  int LIMIT;
+  vector <int> SIZES;
+  //TIMES = number of atoms of the trail each saved state follows from
+  //SAVEDCOUNT, SAVEDLIMIT = size of SAVEDWORDS and LIMIT for each one
+  //SAVEDSIZES = SIZES for each one, one after the other
+  //SAVEDWORDS, SAVEDVALUES = the words of CURRENT changed and their values
+  vector <int> TIMES;
+  vector <int> SAVEDCOUNT;
+  vector <int> SAVEDLIMIT;
+  vector <int> SAVEDSIZES;
+  vector <int> SAVEDWORDS;
+  vector <uint64_t> SAVEDVALUES;
+  //support : returns the bitset of the tuples giving the value to the i-th variable
+  const uint64_t * support(int i, int value) const
+  { return &SUPPORTS[(size_t) (OFFSET[i] + value) * WORDS]; }
+  //domainSize : returns the number of values still possible for the i-th variable
+  int domainSize(const vector <Variable *> & varlist, int i) const;
+  //save : saves the state, if not saved yet at this time
+  void save(int time);
+  //intersect : keeps in CURRENT the tuples that give a value still possible
+  //            to the i-th variable
+  void intersect(const vector <Variable *> & varlist, int i);
+  //supported : returns true if a valid tuple gives the value to the i-th variable
+  bool supported(int i, int value);
+  //explain : adds to atoms those keeping out the values of the variables but
+  //          the i-th one that tuples giving it the value have, any tuple if i
+  //          is -1; returns the number of atoms added
+  int explain(const vector <Variable *> & varlist, int i, int value, vector <LIT> & atoms) const;
+};
+// End of Code
+//
+#endif
+//**************************************************************
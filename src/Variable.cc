@@ -17,6 +17,7 @@ Variable::Variable()
 {
 	VAR = -1;
 	VAL = -1;
+	SAVED = -1;
 	DOMAINSIZE = -1;
 	SAT = false;
 	LEVEL = -1;
@@ -27,6 +28,8 @@ Variable::Variable()
 	ATOMCNTNEG = NULL;
 	ATOMRECPOS = NULL;
 	ATOMRECNEG = NULL;
+	WATCHPOS = NULL;
+	WATCHNEG = NULL;
 	VSIDSCOUNTER=NULL;
 	ATOMINDEX = NULL;
 	FLAG = NULL;
@@ -39,6 +42,7 @@ Variable::Variable(int var, int domain)
 {
 	VAR = var;
 	VAL = -1;
+	SAVED = -1;
 	DOMAINSIZE = domain;
 	SAT = false;
 	LEVEL = -1;
@@ -52,8 +56,10 @@ Variable::Variable(int var, int domain)
 	VSIDSCOUNTER = new int[DOMAINSIZE];
 	FLAG = new bool[DOMAINSIZE];
 	CLAUSEID = new int[DOMAINSIZE];
-	ATOMRECPOS = new VARRECORD *[DOMAINSIZE];
-	ATOMRECNEG = new VARRECORD *[DOMAINSIZE];
+	ATOMRECPOS = new OCCLIST[DOMAINSIZE];
+	ATOMRECNEG = new OCCLIST[DOMAINSIZE];
+	WATCHPOS = new vector<int>[DOMAINSIZE];
+	WATCHNEG = new vector<int>[DOMAINSIZE];
 	for(int i=0; i<DOMAINSIZE; i++)
 	{ // CHANGED DEFAULT ATOMLEVEL TO -10
 		ATOMLEVEL[i] = -10;
@@ -63,8 +69,6 @@ Variable::Variable(int var, int domain)
 		VSIDSCOUNTER[i] = 0;
 		FLAG[i] = false;
 		CLAUSEID[i] = -10;
-		ATOMRECPOS[i] = NULL;
-		ATOMRECNEG[i] = NULL;
 		ATOMINDEX[i] = -1;
 		ATOMWATCH[i] = 0;
 	}
@@ -80,51 +84,23 @@ Variable::~Variable()
 	delete [] FLAG;
 	delete [] CLAUSEID;
 	delete [] VSIDSCOUNTER;
+	delete [] WATCHPOS;
+	delete [] WATCHNEG;
 
-	for(int i=0; i<DOMAINSIZE; i++)
-	{
-		VARRECORD * temp = ATOMRECPOS[i];
-		VARRECORD * temp2;
-		while(temp)
-		{
-			temp2 = temp;
-			temp = temp->next;
-			delete temp2;
-		}
-		temp = ATOMRECNEG[i];
-		while(temp)
-		{
-			temp2 = temp;
-			temp = temp->next;
-			delete temp2;
-		}
-		delete ATOMRECPOS[i];
-		delete ATOMRECNEG[i];
-	}
+	delete [] ATOMRECPOS;
+	delete [] ATOMRECNEG;
+	delete [] ATOMINDEX;
+	delete [] ATOMWATCH;
 }
 
 //AddRecord
 void Variable::addRecord ( int c_id, int d_id, bool flag )
 {
-	//local variable
-	VARRECORD * temp = new VARRECORD;
-	temp->c_num = c_id;
-
-	//if memory allocated
-	if(temp)
-	{
-		//if flag = true then its "="; else "!"
-		if(flag)
-		{
-			temp->next = ATOMRECPOS[d_id];
-			ATOMRECPOS[d_id] = temp;
-		}
-		else
-		{
-			temp->next = ATOMRECNEG[d_id];
-			ATOMRECNEG[d_id] = temp;
-		}
-	}
+	//if flag = true then its "="; else "!"
+	if(flag)
+		ATOMRECPOS[d_id].TAIL.push_back(c_id);
+	else
+		ATOMRECNEG[d_id].TAIL.push_back(c_id);
 }
 
 //Print
@@ -137,26 +113,15 @@ void Variable::Print()
 		cout<<"Domain = "<<i<<endl;
 		//print POS
 		cout<<"(POS Records = ";
-		VARRECORD * curr = ATOMRECPOS[i];
-		while(curr)
-		{
-			cout<<curr->c_num<<" ";
-			curr = curr->next;
-		}
+		for(int j=0; j<ATOMRECPOS[i].size(); j++)
+			cout<<ATOMRECPOS[i][j]<<" ";
 		cout<<")"<<endl;
-		if(curr) delete curr;
 
 		//print NEG
 		cout<<"(NEG Records = ";
-		VARRECORD * curr1 = ATOMRECPOS[i];
-		curr1 = ATOMRECNEG[i];
-		while(curr1)
-		{
-			cout<<curr1->c_num<<" ";
-			curr1 = curr1->next;
-		}
+		for(int j=0; j<ATOMRECNEG[i].size(); j++)
+			cout<<ATOMRECNEG[i][j]<<" ";
 		cout<<")"<<endl<<endl;
-		if (curr1) delete curr1;
 	}
 }
 //End of Code
@@ -21,20 +21,31 @@
 #include <time.h>
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include "Clause.h"
 
 using namespace std;
 //**************************************************************
-// VARRECORD
-// This is a linkedlist which stores the clause number in which
-// the variable with that domain value exists
-struct VARRECORD
+// OCCLIST
+// This is the list of clause numbers in which the variable with
+// that domain value exists. The clauses of the input formula are
+// a slice of the flat occurrence array built by the formula, the
+// clauses added later (learned clauses) are kept in a tail
+struct OCCLIST
 {
-  //c_num = clause number
-  int c_num;
-  //next = link to next element
-  VARRECORD * next;
+  //BASE = start of the slice in the flat occurrence array
+  //NUMBASE = number of clause numbers in the slice
+  //TAIL = clause numbers added after the array was built
+  int * BASE;
+  int NUMBASE;
+  vector<int> TAIL;
+
+  OCCLIST() : BASE(NULL), NUMBASE(0) {}
+  //size : number of occurrences
+  int size() const { return NUMBASE + (int) TAIL.size(); }
+  //operator[] : clause number of the i-th occurrence
+  int operator[] ( int i ) const { return i < NUMBASE ? BASE[i] : TAIL[i - NUMBASE]; }
 };
 
 // Variable
@@ -51,6 +62,7 @@ class Variable
 public:
   //VAR = variable name
   //VAL = value assigned to this variable
+  //SAVED = value the variable held when it was last unassigned, -1 if none
   //DOMAINSIZE = size of variable's domain
   //SAT = boolean variable true if variable assigned else false
   //LEVEL = Level at which the variable got satisfied and assigned , default -1
@@ -61,8 +73,11 @@ public:
   //ATOMCNTPOS = array storing counts of positive occurences of each domain - for choosing decision literal
   //ATOMCNTNEG = array storing counts of negative occurences of each domain
 
-  //ATOMRECPOS = array storing records of positive occurences of each domain
-  //ATOMRECNEG = array storing records of negative occurences of each domain
+  //ATOMRECPOS = array storing clause numbers of positive occurences of each domain
+  //ATOMRECNEG = array storing clause numbers of negative occurences of each domain
+
+  //WATCHPOS = array storing ids of clauses watching the positive literal of each domain
+  //WATCHNEG = array storing ids of clauses watching the negative literal of each domain
 
   //FLAG = array storing true if the literal is involved in conflict
   //CLAUSEID = array storing the clause id which cause this literal to be
@@ -70,6 +85,7 @@ public:
 
   int VAR;
   int VAL;
+  int SAVED;
   int DOMAINSIZE;
   bool SAT;
   int LEVEL;
@@ -85,8 +101,10 @@ public:
   int * VSIDSCOUNTER; // need this for choosing a decision literal with vsids
   bool * FLAG;
   int * CLAUSEID;
-  VARRECORD ** ATOMRECPOS;
-  VARRECORD ** ATOMRECNEG;
+  OCCLIST * ATOMRECPOS;
+  OCCLIST * ATOMRECNEG;
+  vector<int> * WATCHPOS;
+  vector<int> * WATCHNEG;
   //public variables and functions
 public:
   //Zero argument constructor
@@ -95,7 +113,7 @@ public:
   Variable(int var, int domain);
   //Destructor
   ~Variable();
-  //AddRecord : adds the record to appropriate fields, true = '='; false= '!'
+  //AddRecord : adds the clause to the tail of the appropriate list, true = '='; false= '!'
   void addRecord(int c_id, int d_id, bool flag);
   //Print : prints the indexes of the clause for each var domain
   void Print();